@@ -10,7 +10,9 @@ void solve_and_print(const std::string& task_name, MeteoNumerical::Common::Matri
     std::cout << "\n--- Zadanie " << task_name << " ---\n";
 
     try {
-        MeteoNumerical::Common::ValueSeries x = MeteoNumerical::LinearAlgebra::gaussElimination(A, b);
+        // Obserwator wypisuje macierz po każdym kroku eliminacji
+        MeteoNumerical::Common::ValueSeries x = MeteoNumerical::LinearAlgebra::gaussElimination(
+            A, b, MeteoNumerical::LinearAlgebra::printingGaussObserver(std::cout, 4));
 
         std::cout << "Rozwiazanie (wektor x):\n";
         MeteoNumerical::LinearAlgebra::printVector(x);
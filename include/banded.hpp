@@ -0,0 +1,87 @@
+#ifndef METEO_BANDED_HPP
+#define METEO_BANDED_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include <vector>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    // --- Układy trójdiagonalne (algorytm Thomasa, O(n)) ---
+    // lower[i] = A(i+1, i), diag[i] = A(i, i), upper[i] = A(i, i+1); lower i upper mają n-1 elementów.
+    // Algorytm nie wybiera elementu głównego - wymaga np. dominacji przekątniowej.
+    Common::ValueSeries thomasSolve(const Common::ValueSeries& lower, const Common::ValueSeries& diag,
+                                    const Common::ValueSeries& upper, const Common::ValueSeries& rhs);
+
+    // Wersja bez alokacji: rhs nadpisywane rozwiązaniem, work ma co najmniej n elementów.
+    void thomasSolveInPlace(size_t n, const double* lower, const double* diag, const double* upper,
+                            double* rhs, double* work);
+
+    // Wiele niezależnych układów rozmiaru n przechowywanych z przeplotem: element i układu s
+    // leży pod indeksem i * batch + s, więc pętla po układach jest wektoryzowana.
+    // lower/upper mają (n-1) * batch elementów; rhs jest nadpisywane rozwiązaniami.
+    void thomasSolveBatched(size_t n, size_t batch, const double* lower, const double* diag,
+                            const double* upper, double* rhs, unsigned num_threads = 0);
+
+    // --- Macierze pasmowe ---
+    // Zwarta pamięć wierszami: wiersz i przechowuje kolumny [i - kl, i + ku + kl];
+    // dodatkowe kl kolumn mieści wypełnienie powstające przy wyborze elementu głównego.
+    class BandedMatrix {
+    public:
+        BandedMatrix() = default;
+        BandedMatrix(size_t n, size_t kl, size_t ku);
+
+        static BandedMatrix fromDense(Common::ConstMatrixView A, size_t kl, size_t ku);
+
+        size_t size() const { return n_; }
+        size_t lowerBandwidth() const { return kl_; }
+        size_t upperBandwidth() const { return ku_; }
+        size_t storageWidth() const { return width_; }
+
+        bool inBand(size_t i, size_t j) const { return j + kl_ >= i && j <= i + ku_; }
+        double& at(size_t i, size_t j);
+        double get(size_t i, size_t j) const;
+
+        Common::ValueSeries multiply(const Common::ValueSeries& x) const;
+
+        // Bezpośredni dostęp dla rozkładu (kolumny poza pasmem A, ale w pamięci wypełnienia)
+        double& raw(size_t i, size_t j) { return data_[i * width_ + (j + kl_ - i)]; }
+        double raw(size_t i, size_t j) const { return data_[i * width_ + (j + kl_ - i)]; }
+
+    private:
+        size_t n_ = 0;
+        size_t kl_ = 0;
+        size_t ku_ = 0;
+        size_t width_ = 0;
+        std::vector<double> data_;
+    };
+
+    // Rozkład LU macierzy pasmowej z częściowym wyborem elementu głównego (jak LAPACK gbtrf):
+    // mnożniki L zostają w miejscu wyeliminowanych elementów, U ma szerokość pasma kl + ku.
+    class BandedLUFactorization {
+    public:
+        BandedLUFactorization() = default;
+        explicit BandedLUFactorization(BandedMatrix A);
+
+        bool factor(BandedMatrix A); // false dla macierzy osobliwej
+        bool isFactored() const { return factored_; }
+        size_t size() const { return lu_.size(); }
+
+        Common::ValueSeries solve(const Common::ValueSeries& b) const;
+        void solveInPlace(Common::ValueSeries& b) const;
+
+    private:
+        BandedMatrix lu_;
+        Common::IndexVector pivots_;
+        bool factored_ = false;
+    };
+
+    // Rozwiązuje niezależne układy pasmowe równolegle; rhs[s] jest nadpisywane rozwiązaniem.
+    void solveBandedBatched(const std::vector<BandedMatrix>& systems, std::vector<Common::ValueSeries>& rhs,
+                            unsigned num_threads = 0);
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_BANDED_HPP
@@ -0,0 +1,25 @@
+#ifndef METEO_BATCHED_HPP
+#define METEO_BATCHED_HPP
+
+#include "common.hpp"
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    // Wiele niezależnych małych układów gęstych tego samego rozmiaru (typowo 4x4 - 10x10).
+    // Układ s: macierz n x n (wierszami) od A + s * a_stride, prawa strona od b + s * b_stride,
+    // rozwiązanie zapisywane od x + s * x_stride (x może wskazywać na b).
+    // Układy są przepakowywane porcjami po 8 do układu SoA (element (i, j) ośmiu układów obok siebie)
+    // i rozwiązywane eliminacją Gaussa z częściowym wyborem elementu głównego równolegle w lanach SIMD;
+    // dla n <= 10 jądra mają rozmiar znany w czasie kompilacji. Porcje są dzielone między wątki.
+    // Zwraca liczbę układów osobliwych: ich rozwiązanie to NaN, a singular[s] = 1 (jeśli podano).
+    size_t solveSmallSystemsBatched(size_t n, size_t batch,
+                                    const double* A, size_t a_stride,
+                                    const double* b, size_t b_stride,
+                                    double* x, size_t x_stride,
+                                    unsigned char* singular = nullptr, unsigned num_threads = 0);
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_BATCHED_HPP
@@ -0,0 +1,59 @@
+#ifndef METEO_CHEBYSHEV_HPP
+#define METEO_CHEBYSHEV_HPP
+
+#include "common.hpp"
+#include "integration.hpp" // Dla IntegrableFunction
+
+namespace MeteoNumerical {
+namespace Approximation {
+
+    // Szereg Czebyszewa p(x) = sum_k c_k T_k(y), y = (2x - a - b) / (b - a), na przedziale [a, b].
+    // Współczynniki interpolanta w punktach Czebyszewa-Lobatto liczone są transformatą DCT-I
+    // (przez FFT) w O(n log n); wartościowanie to rekurencja Clenshawa, stabilna także dla
+    // wysokich stopni, w przeciwieństwie do bazy jednomianów.
+    class ChebyshevSeries {
+    public:
+        ChebyshevSeries() = default;
+        ChebyshevSeries(double a, double b, const Common::ValueSeries& coefficients);
+
+        // n punktów Czebyszewa drugiego rodzaju na [a, b], rosnąco (z końcami przedziału).
+        static Common::ValueSeries points(double a, double b, size_t n);
+        // Interpolant przez wartości values[i] = f(points(a, b, n)[i]).
+        static ChebyshevSeries fromValues(double a, double b, const Common::ValueSeries& values);
+        static ChebyshevSeries interpolate(const Integration::IntegrableFunction& f, double a, double b, size_t n);
+        // Podwaja liczbę punktów (17, 33, 65, ...; wcześniejsze próbki są wykorzystywane ponownie), aż
+        // końcowe współczynniki spadną poniżej tolerance * max|c_k|, po czym obcina szereg.
+        // *converged (opcjonalnie) mówi, czy tolerancję osiągnięto przed max_points.
+        static ChebyshevSeries adaptive(const Integration::IntegrableFunction& f, double a, double b,
+                                        double tolerance = 1e-13, size_t max_points = 65537,
+                                        bool* converged = nullptr);
+
+        // Usuwa końcowe współczynniki |c_k| <= tolerance * max|c_k| (zawsze zostaje c_0).
+        void truncate(double tolerance);
+
+        double operator()(double x) const { return evaluate(x); }
+        double evaluate(double x) const;
+        // Clenshaw dla bloków punktów w lanach SIMD.
+        void evaluate(const double* x, double* out, size_t count) const;
+        Common::ValueSeries evaluate(const Common::ValueSeries& x) const;
+
+        ChebyshevSeries derivative() const;
+        double definiteIntegral() const; // całka z p na [a, b]
+
+        const Common::ValueSeries& coefficients() const { return coeffs_; }
+        size_t degree() const { return coeffs_.empty() ? 0 : coeffs_.size() - 1; }
+        double lower() const { return a_; }
+        double upper() const { return b_; }
+
+    private:
+        void requireValid(const char* where) const;
+
+        double a_ = -1.0;
+        double b_ = 1.0;
+        Common::ValueSeries coeffs_;
+    };
+
+} // namespace Approximation
+} // namespace MeteoNumerical
+
+#endif // METEO_CHEBYSHEV_HPP
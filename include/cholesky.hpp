@@ -0,0 +1,55 @@
+#ifndef METEO_CHOLESKY_HPP
+#define METEO_CHOLESKY_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include "condition.hpp"
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    struct LDLTOptions {
+        size_t block_size = 64;
+        unsigned num_threads = 0; // 0 = wszystkie rdzenie
+    };
+
+    // Rozkład A = L D L^T macierzy symetrycznej dodatnio określonej (wariant Cholesky'ego bez pierwiastków).
+    // Czytany jest wyłącznie dolny trójkąt A. L (z jedynkami na przekątnej) i D są przechowywane
+    // razem w dolnym trójkącie jednej macierzy: D na przekątnej, L pod nią.
+    class LDLTFactorization {
+    public:
+        LDLTFactorization() = default;
+        explicit LDLTFactorization(Common::ConstMatrixView A, const LDLTOptions& options = LDLTOptions());
+        explicit LDLTFactorization(const Common::Matrix& A, const LDLTOptions& options = LDLTOptions());
+
+        // false, gdy macierz nie jest dodatnio określona (d_k < DEFAULT_EPSILON) lub nie jest kwadratowa
+        bool factor(Common::ConstMatrixView A, const LDLTOptions& options = LDLTOptions());
+
+        bool isFactored() const { return factored_; }
+        size_t size() const { return ld_.rows(); }
+        const Common::DenseMatrix& packedLDLT() const { return ld_; }
+        Common::ValueSeries diagonalD() const;
+
+        Common::ValueSeries solve(const Common::ValueSeries& b) const;
+        void solveInPlace(Common::ValueSeries& b) const;
+        Common::DenseMatrix solve(Common::ConstMatrixView B) const;
+        void solveInPlace(Common::MatrixView B) const;
+
+        double determinant() const;
+        // Estymata uwarunkowania (A symetryczna, więc wystarczy solve) i wzrost elementów D L^T
+        FactorizationDiagnostics diagnostics() const;
+
+    private:
+        void requireFactored(const char* where) const;
+        bool factorPanel(size_t j0, size_t jb);
+
+        Common::DenseMatrix ld_;
+        double norm1_ = 0.0;
+        double max_abs_ = 0.0;
+        bool factored_ = false;
+    };
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_CHOLESKY_HPP
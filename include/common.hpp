@@ -5,6 +5,7 @@
 #include <string>
 #include <numeric>
 #include <cmath>
+#include <cstddef>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -28,6 +29,11 @@ namespace Common {
         }
         return result;
     }
+
+    // Wersja wsadowa: out[i] = p(x[i]) dla i < count. Schemat Hornera liczony jest jednocześnie
+    // dla bloków punktów w lanach SIMD (klony AVX-512/AVX2 wybierane w czasie działania).
+    void evaluatePolynomialHornerBatch(const ValueSeries& coefficients, const double* x, double* out, size_t count);
+    ValueSeries evaluatePolynomialHornerBatch(const ValueSeries& coefficients, const ValueSeries& x);
 } // namespace Common
 } // namespace MeteoNumerical
 
@@ -0,0 +1,80 @@
+#ifndef METEO_CONDITION_HPP
+#define METEO_CONDITION_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    // Wskaźniki jakości rozkładu liczone w O(n^2) z gotowych czynników.
+    struct FactorizationDiagnostics {
+        double norm1 = 0.0;                // ||A||_1
+        double condition_estimate = 0.0;   // estymata kappa_1(A) = ||A||_1 ||A^{-1}||_1 (dolne ograniczenie)
+        double reciprocal_condition = 0.0; // 1 / condition_estimate, jak rcond w LAPACK
+        double pivot_growth = 0.0;         // max|U_ij| / max|A_ij| - duży wzrost oznacza niestabilną eliminację
+    };
+
+    inline double matrixNorm1(Common::ConstMatrixView A) {
+        Common::ValueSeries col_sums(A.cols(), 0.0);
+        for (size_t i = 0; i < A.rows(); ++i) {
+            const double* row = A.rowPtr(i);
+            for (size_t j = 0; j < A.cols(); ++j) col_sums[j] += std::abs(row[j]);
+        }
+        return col_sums.empty() ? 0.0 : *std::max_element(col_sums.begin(), col_sums.end());
+    }
+
+    // Estymator Hagera-Highama normy ||A^{-1}||_1 (jak LAPACK xLACN2): kilka rozwiązań z A i A^T
+    // zamiast odwracania macierzy. solve(x) i solveT(x) rozwiązują w miejscu A y = x oraz A^T y = x
+    // (x to Common::ValueSeries).
+    template <typename Solve, typename SolveT>
+    double estimateInverseNorm1(size_t n, Solve&& solve, SolveT&& solveT) {
+        if (n == 0) return 0.0;
+        auto norm1 = [](const Common::ValueSeries& v) {
+            double sum = 0.0;
+            for (double x : v) sum += std::abs(x);
+            return sum;
+        };
+
+        Common::ValueSeries x(n, 1.0 / static_cast<double>(n));
+        double estimate = 0.0;
+        size_t last_j = n;
+        for (int iter = 0; iter < 5; ++iter) {
+            solve(x);
+            const double norm = norm1(x);
+            if (iter > 0 && norm <= estimate) break;
+            estimate = norm;
+            for (double& v : x) v = (v >= 0.0) ? 1.0 : -1.0;
+            solveT(x);
+            size_t j = 0;
+            for (size_t i = 1; i < n; ++i) {
+                if (std::abs(x[i]) > std::abs(x[j])) j = i;
+            }
+            if (j == last_j) break;
+            last_j = j;
+            std::fill(x.begin(), x.end(), 0.0);
+            x[j] = 1.0;
+        }
+
+        // Dodatkowy wektor o naprzemiennych znakach (Higham) chroni przed złośliwymi przypadkami
+        for (size_t i = 0; i < n; ++i) {
+            const double magnitude = 1.0 + (n > 1 ? static_cast<double>(i) / static_cast<double>(n - 1) : 0.0);
+            x[i] = (i % 2 == 0) ? magnitude : -magnitude;
+        }
+        solve(x);
+        return std::max(estimate, 2.0 * norm1(x) / (3.0 * static_cast<double>(n)));
+    }
+
+    // Uzupełnia condition_estimate i reciprocal_condition na podstawie norm1 i ||A^{-1}||_1.
+    inline void setConditionEstimate(FactorizationDiagnostics& diagnostics, double inverse_norm1) {
+        diagnostics.condition_estimate = diagnostics.norm1 * inverse_norm1;
+        diagnostics.reciprocal_condition = diagnostics.condition_estimate > 0.0 && std::isfinite(diagnostics.condition_estimate)
+                ? 1.0 / diagnostics.condition_estimate : 0.0;
+    }
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_CONDITION_HPP
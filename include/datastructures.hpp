@@ -15,6 +15,13 @@ namespace DataStructures {
                 : temperature_celsius(temp), humidity_percent(hum), pressure_hpa(press), wind_speed_mps(wind) {}
     };
     using MeasurementSeries = std::vector<Measurement>;
+
+    // Położenie stacji w płaskim układzie współrzędnych (np. km w odwzorowaniu kartograficznym).
+    struct StationLocation {
+        double x;
+        double y;
+        StationLocation(double x_ = NAN, double y_ = NAN) : x(x_), y(y_) {}
+    };
 } // namespace DataStructures
 } // namespace MeteoNumerical
 
@@ -0,0 +1,179 @@
+#ifndef METEO_DENSEMATRIX_HPP
+#define METEO_DENSEMATRIX_HPP
+
+#include "common.hpp"
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+namespace MeteoNumerical {
+namespace Common {
+
+    // Nie-właścicielski widok wektora o dowolnym kroku (wiersz: stride = 1, kolumna: stride = ld).
+    template <typename T>
+    class BasicVectorView {
+    public:
+        BasicVectorView() = default;
+        BasicVectorView(T* data, size_t size, size_t stride = 1)
+                : data_(data), size_(size), stride_(stride) {}
+
+        T& operator[](size_t i) const { return data_[i * stride_]; }
+        T* data() const { return data_; }
+        size_t size() const { return size_; }
+        size_t stride() const { return stride_; }
+        bool empty() const { return size_ == 0; }
+
+        operator BasicVectorView<const T>() const { return BasicVectorView<const T>(data_, size_, stride_); }
+
+    private:
+        T* data_ = nullptr;
+        size_t size_ = 0;
+        size_t stride_ = 1;
+    };
+
+    using VectorView = BasicVectorView<double>;
+    using ConstVectorView = BasicVectorView<const double>;
+
+    // Nie-właścicielski widok macierzy w układzie wierszowym z wiodącym wymiarem ld >= cols.
+    template <typename T>
+    class BasicMatrixView {
+    public:
+        BasicMatrixView() = default;
+        BasicMatrixView(T* data, size_t rows, size_t cols, size_t ld)
+                : data_(data), rows_(rows), cols_(cols), ld_(ld) {
+            if (ld_ < cols_) {
+                throw std::runtime_error("MatrixView: leading dimension smaller than column count.");
+            }
+        }
+        BasicMatrixView(T* data, size_t rows, size_t cols) : BasicMatrixView(data, rows, cols, cols) {}
+
+        T& operator()(size_t i, size_t j) const { return data_[i * ld_ + j]; }
+        T* data() const { return data_; }
+        T* rowPtr(size_t i) const { return data_ + i * ld_; }
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t ld() const { return ld_; }
+        bool empty() const { return rows_ == 0 || cols_ == 0; }
+        bool isSquare() const { return rows_ == cols_; }
+
+        BasicVectorView<T> row(size_t i) const { return BasicVectorView<T>(rowPtr(i), cols_, 1); }
+        BasicVectorView<T> column(size_t j) const { return BasicVectorView<T>(data_ + j, rows_, ld_); }
+
+        BasicMatrixView block(size_t row0, size_t col0, size_t nrows, size_t ncols) const {
+            if (row0 + nrows > rows_ || col0 + ncols > cols_) {
+                throw std::out_of_range("MatrixView::block: block exceeds matrix bounds.");
+            }
+            return BasicMatrixView(data_ + row0 * ld_ + col0, nrows, ncols, ld_);
+        }
+
+        operator BasicMatrixView<const T>() const { return BasicMatrixView<const T>(data_, rows_, cols_, ld_); }
+
+    private:
+        T* data_ = nullptr;
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        size_t ld_ = 0;
+    };
+
+    using MatrixView = BasicMatrixView<double>;
+    using ConstMatrixView = BasicMatrixView<const double>;
+    using FloatMatrixView = BasicMatrixView<float>;
+    using ConstFloatMatrixView = BasicMatrixView<const float>;
+
+    // Gęsta macierz przechowywana w jednym ciągłym buforze (wierszami).
+    // ld (leading dimension) pozwala na dopełnienie wierszy, np. do wyrównania pod SIMD.
+    class DenseMatrix {
+    public:
+        DenseMatrix() = default;
+        DenseMatrix(size_t rows, size_t cols, double value = 0.0, size_t ld = 0)
+                : rows_(rows), cols_(cols), ld_(ld == 0 ? cols : ld) {
+            if (ld_ < cols_) {
+                throw std::runtime_error("DenseMatrix: leading dimension smaller than column count.");
+            }
+            data_.assign(rows_ * ld_, value);
+        }
+        explicit DenseMatrix(const Matrix& nested) { assign(nested); }
+        explicit DenseMatrix(ConstMatrixView view) : DenseMatrix(view.rows(), view.cols()) {
+            for (size_t i = 0; i < rows_; ++i) {
+                std::copy(view.rowPtr(i), view.rowPtr(i) + cols_, rowPtr(i));
+            }
+        }
+
+        static DenseMatrix identity(size_t n) {
+            DenseMatrix I(n, n);
+            for (size_t i = 0; i < n; ++i) I(i, i) = 1.0;
+            return I;
+        }
+
+        void assign(const Matrix& nested) {
+            size_t rows = nested.size();
+            size_t cols = rows > 0 ? nested[0].size() : 0;
+            for (const auto& r : nested) {
+                if (r.size() != cols) {
+                    throw std::runtime_error("DenseMatrix: nested matrix rows have different lengths.");
+                }
+            }
+            rows_ = rows;
+            cols_ = cols;
+            ld_ = cols;
+            data_.resize(rows_ * ld_);
+            for (size_t i = 0; i < rows_; ++i) {
+                std::copy(nested[i].begin(), nested[i].end(), rowPtr(i));
+            }
+        }
+
+        Matrix toNested() const {
+            Matrix nested(rows_, ValueSeries(cols_));
+            for (size_t i = 0; i < rows_; ++i) {
+                std::copy(rowPtr(i), rowPtr(i) + cols_, nested[i].begin());
+            }
+            return nested;
+        }
+
+        double& operator()(size_t i, size_t j) { return data_[i * ld_ + j]; }
+        double operator()(size_t i, size_t j) const { return data_[i * ld_ + j]; }
+
+        double* data() { return data_.data(); }
+        const double* data() const { return data_.data(); }
+        double* rowPtr(size_t i) { return data_.data() + i * ld_; }
+        const double* rowPtr(size_t i) const { return data_.data() + i * ld_; }
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t ld() const { return ld_; }
+        bool empty() const { return rows_ == 0 || cols_ == 0; }
+        bool isSquare() const { return rows_ == cols_; }
+
+        MatrixView view() { return MatrixView(data(), rows_, cols_, ld_); }
+        ConstMatrixView view() const { return ConstMatrixView(data(), rows_, cols_, ld_); }
+        operator MatrixView() { return view(); }
+        operator ConstMatrixView() const { return view(); }
+
+        VectorView row(size_t i) { return view().row(i); }
+        ConstVectorView row(size_t i) const { return view().row(i); }
+        VectorView column(size_t j) { return view().column(j); }
+        ConstVectorView column(size_t j) const { return view().column(j); }
+        MatrixView block(size_t row0, size_t col0, size_t nrows, size_t ncols) {
+            return view().block(row0, col0, nrows, ncols);
+        }
+        ConstMatrixView block(size_t row0, size_t col0, size_t nrows, size_t ncols) const {
+            return view().block(row0, col0, nrows, ncols);
+        }
+
+        void swapRows(size_t i, size_t j) {
+            if (i != j) std::swap_ranges(rowPtr(i), rowPtr(i) + cols_, rowPtr(j));
+        }
+        void fill(double value) { std::fill(data_.begin(), data_.end(), value); }
+
+    private:
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        size_t ld_ = 0;
+        std::vector<double> data_;
+    };
+
+} // namespace Common
+} // namespace MeteoNumerical
+
+#endif // METEO_DENSEMATRIX_HPP
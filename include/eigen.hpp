@@ -0,0 +1,64 @@
+#ifndef METEO_EIGEN_HPP
+#define METEO_EIGEN_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include <functional>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    struct SymmetricEigenOptions {
+        bool compute_vectors = true;
+        unsigned num_threads = 0; // wątki redukcji i transformacji wstecznej (0 = wszystkie rdzenie)
+    };
+
+    // Wartości własne rosnąco; kolumna j macierzy eigenvectors odpowiada eigenvalues[j].
+    struct SymmetricEigenResult {
+        Common::ValueSeries eigenvalues;
+        Common::DenseMatrix eigenvectors; // n x n, pusta przy compute_vectors == false
+    };
+
+    // Pełny rozkład A = V diag(lambda) V^T macierzy symetrycznej: redukcja Householdera do postaci
+    // trójdiagonalnej i niejawny algorytm QR z przesunięciem Wilkinsona. Czytany jest tylko dolny trójkąt A.
+    SymmetricEigenResult symmetricEigen(Common::ConstMatrixView A,
+                                        const SymmetricEigenOptions& options = SymmetricEigenOptions());
+    SymmetricEigenResult symmetricEigen(const Common::Matrix& A,
+                                        const SymmetricEigenOptions& options = SymmetricEigenOptions());
+
+    // Macierz trójdiagonalna: diagonal (n) i off_diagonal (n - 1) pod/nad przekątną.
+    SymmetricEigenResult tridiagonalEigen(const Common::ValueSeries& diagonal,
+                                          const Common::ValueSeries& off_diagonal,
+                                          bool compute_vectors = true);
+
+    struct LanczosOptions {
+        size_t subspace_size = 0;   // 0: max(2k + 20, 40), nie więcej niż n
+        size_t max_restarts = 500;
+        double tolerance = 1e-10;   // ||A x - lambda x|| <= tolerance * max|lambda|
+        unsigned num_threads = 0;   // wątki mnożenia przez gęstą macierz
+        unsigned seed = 12345;      // wektor startowy
+    };
+
+    struct LanczosResult {
+        Common::ValueSeries eigenvalues;     // k największych, malejąco
+        Common::DenseMatrix eigenvectors;    // n x k
+        Common::ValueSeries residual_norms;  // ||A x_j - lambda_j x_j||
+        size_t matvecs = 0;
+        size_t restarts = 0;
+        bool converged = false;
+    };
+
+    // y = A x dla symetrycznego operatora rozmiaru n (np. kowariancji liczonej bez jej jawnego tworzenia).
+    using SymmetricOperator = std::function<void(const double* x, double* y)>;
+
+    // k największych wartości własnych metodą Lanczosa z pełną reortogonalizacją i grubym restartem
+    // (thick restart): koszt to głównie kilkadziesiąt-kilkaset mnożeń A x zamiast O(n^3) pełnego rozkładu.
+    LanczosResult lanczosTopK(Common::ConstMatrixView A, size_t k,
+                              const LanczosOptions& options = LanczosOptions());
+    LanczosResult lanczosTopK(size_t n, const SymmetricOperator& apply, size_t k,
+                              const LanczosOptions& options = LanczosOptions());
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_EIGEN_HPP
@@ -0,0 +1,43 @@
+#ifndef METEO_GEMM_HPP
+#define METEO_GEMM_HPP
+
+#include "densematrix.hpp"
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+    enum class Transpose { No, Yes };
+
+    // Mikrojądra mnożenia macierzy; Auto wybiera najszybsze wspierane przez procesor.
+    enum class GemmKernel { Auto, Scalar, AVX2, AVX512 };
+
+    // C = alpha * op(A) * op(B) + beta * C, gdzie op(X) = X lub X^T.
+    // Przy beta == 0 zawartość C jest ignorowana (także NaN).
+    void gemm(Transpose transA, Transpose transB, double alpha,
+              Common::ConstMatrixView A, Common::ConstMatrixView B,
+              double beta, Common::MatrixView C);
+
+    void gemm(double alpha, Common::ConstMatrixView A, Common::ConstMatrixView B,
+              double beta, Common::MatrixView C);
+
+    // Wersja wielowątkowa: C jest dzielona na kafelki liczone niezależnie przez gemm().
+    // num_threads == 0 oznacza wszystkie dostępne rdzenie.
+    void gemmParallel(Transpose transA, Transpose transB, double alpha,
+                      Common::ConstMatrixView A, Common::ConstMatrixView B,
+                      double beta, Common::MatrixView C, unsigned num_threads = 0);
+
+    // Odpowiedniki pojedynczej precyzji (dwa razy szersze wektory SIMD), m.in. dla rozkładu LU
+    // w trybie mieszanej precyzji.
+    void gemm(Transpose transA, Transpose transB, float alpha,
+              Common::ConstFloatMatrixView A, Common::ConstFloatMatrixView B,
+              float beta, Common::FloatMatrixView C);
+    void gemmParallel(Transpose transA, Transpose transB, float alpha,
+                      Common::ConstFloatMatrixView A, Common::ConstFloatMatrixView B,
+                      float beta, Common::FloatMatrixView C, unsigned num_threads = 0);
+
+    bool isGemmKernelSupported(GemmKernel kernel);
+    void setGemmKernel(GemmKernel kernel);
+    GemmKernel activeGemmKernel();
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_GEMM_HPP
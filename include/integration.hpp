@@ -3,21 +3,241 @@
 
 #include "common.hpp"
 #include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace MeteoNumerical {
 namespace Integration {
     using IntegrableFunction = std::function<double(double)>;
 
+    // Wersje szablonowe przyjmują dowolny obiekt wywoływalny (lambda, wskaźnik do funkcji, funktor)
+    // bez opakowywania w std::function, więc wywołanie f może zostać wstawione w pętlę sumowania.
+    // Wersje z IntegrableFunction są cienkimi nakładkami na nie.
+    template <typename F>
+    double rectangleRule(F&& f, double a, double b, int partitions) {
+        if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
+        double sum = 0.0;
+        double h = (b - a) / partitions;
+        for (int i = 0; i < partitions; ++i) {
+            sum += f(a + (i + 0.5) * h);
+        }
+        return sum * h;
+    }
+
+    template <typename F>
+    double trapezoidalRule(F&& f, double a, double b, int partitions) {
+        if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
+        double h = (b - a) / partitions;
+        double sum = 0.5 * (f(a) + f(b));
+        for (int i = 1; i < partitions; ++i) {
+            sum += f(a + i * h);
+        }
+        return sum * h;
+    }
+
+    template <typename F>
+    double simpsonRule(F&& f, double a, double b, int partitions) {
+        if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
+        if (partitions % 2 != 0) partitions++;
+        double h = (b - a) / partitions;
+        double sum = f(a) + f(b);
+        // Węzły nieparzyste (waga 4) i parzyste (waga 2) osobno - bez rozgałęzienia w pętli
+        double odd = 0.0, even = 0.0;
+        for (int i = 1; i < partitions; i += 2) odd += f(a + i * h);
+        for (int i = 2; i < partitions; i += 2) even += f(a + i * h);
+        return (sum + 4.0 * odd + 2.0 * even) * h / 3.0;
+    }
+
     double rectangleRule(IntegrableFunction f, double a, double b, int partitions);
     double trapezoidalRule(IntegrableFunction f, double a, double b, int partitions);
     double simpsonRule(IntegrableFunction f, double a, double b, int partitions);
 
     namespace GaussLegendre {
+        // Węzły (rosnąco) i wagi kwadratury n-punktowej na [-1, 1] w ciągłych tablicach.
+        struct Rule {
+            const double* nodes;
+            const double* weights;
+            int size;
+        };
+        // Dowolne n >= 1. Reguły do 10 punktów pochodzą z tablic constexpr; większe są liczone raz
+        // (Newton na rekurencji Legendre'a, O(n^2)) i trzymane w pamięci podręcznej bezpiecznej
+        // wątkowo. Wskaźniki pozostają ważne do końca programu.
+        Rule rule(int num_points);
+
+        template <typename F>
+        double quadrature(F&& func, double a, double b, int num_points) {
+            const Rule r = rule(num_points);
+            double sum = 0.0;
+            double transform_coeff1 = 0.5 * (b - a);
+            double transform_coeff2 = 0.5 * (a + b);
+            for (int i = 0; i < r.size; ++i) {
+                sum += r.weights[i] * func(transform_coeff1 * r.nodes[i] + transform_coeff2);
+            }
+            return sum * transform_coeff1;
+        }
+
+        template <typename F>
+        double composite(F&& func, double a, double b, int num_points_per_interval, int num_partitions) {
+            if (num_partitions <= 0) throw std::runtime_error("Partitions must be positive.");
+            const Rule r = rule(num_points_per_interval); // raz, a nie dla każdego podprzedziału
+            double interval_size = (b - a) / num_partitions;
+            double half = 0.5 * interval_size;
+            double total_sum = 0.0;
+            for (int p = 0; p < num_partitions; ++p) {
+                double center = a + (p + 0.5) * interval_size;
+                double sum = 0.0;
+                for (int i = 0; i < r.size; ++i) {
+                    sum += r.weights[i] * func(half * r.nodes[i] + center);
+                }
+                total_sum += sum;
+            }
+            return total_sum * half;
+        }
+
         double quadrature(IntegrableFunction func, double a, double b, int num_points);
         double composite(IntegrableFunction func, double a, double b, int num_points_per_interval, int num_partitions);
-        // Uwaga: Stałe GL_NODES i GL_WEIGHTS zostaną umieszczone w pliku .cpp
     } // namespace GaussLegendre
+
+    namespace GaussKronrod {
+        enum class Rule {
+            G7K15, // 15 punktów Kronroda (stopień 22), osadzona reguła Gaussa 7-punktowa
+            G10K21 // 21 punktów Kronroda (stopień 31), osadzona reguła Gaussa 10-punktowa
+        };
+
+        // Węzły na [0, 1] od największego (xgk[kronrod_half - 1] = 0); węzły Gaussa to xgk[1], xgk[3], ...
+        struct Nodes {
+            const double* xgk;
+            const double* wgk;
+            const double* wg;
+            int kronrod_half; // liczba węzłów xgk (ze środkiem)
+            int gauss_half;   // liczba wag wg
+            bool gauss_center; // czy środek przedziału jest też węzłem Gaussa (reguła o nieparzystej liczbie punktów)
+        };
+        Nodes nodes(Rule rule);
+
+        struct Estimate {
+            double value;
+            double error; // oszacowanie błędu jak w QUADPACK (różnica Kronrod - Gauss, skalowana)
+        };
+
+        // Jedna reguła Kronroda na [a, b] wraz z oszacowaniem błędu.
+        template <typename F>
+        Estimate estimate(F&& f, const Nodes& r, double a, double b) {
+            const double center = 0.5 * (a + b);
+            const double half = 0.5 * (b - a);
+            const int last = r.kronrod_half - 1;
+            const double fc = f(center);
+            double resk = r.wgk[last] * fc;
+            double resg = r.gauss_center ? r.wg[r.gauss_half - 1] * fc : 0.0;
+            double resabs = std::abs(resk);
+            double fv1[16], fv2[16];
+            for (int j = 0; j < last; ++j) {
+                const double dx = half * r.xgk[j];
+                fv1[j] = f(center - dx);
+                fv2[j] = f(center + dx);
+                const double sum = fv1[j] + fv2[j];
+                resk += r.wgk[j] * sum;
+                resabs += r.wgk[j] * (std::abs(fv1[j]) + std::abs(fv2[j]));
+                if (j % 2 == 1) resg += r.wg[j / 2] * sum;
+            }
+            const double reskh = 0.5 * resk;
+            double resasc = r.wgk[last] * std::abs(fc - reskh);
+            for (int j = 0; j < last; ++j) resasc += r.wgk[j] * (std::abs(fv1[j] - reskh) + std::abs(fv2[j] - reskh));
+            const double scale = std::abs(half);
+            resabs *= scale;
+            resasc *= scale;
+            double error = std::abs((resk - resg) * half);
+            if (resasc != 0.0 && error != 0.0) error = resasc * std::min(1.0, std::pow(200.0 * error / resasc, 1.5));
+            const double epsilon = std::numeric_limits<double>::epsilon();
+            if (resabs > std::numeric_limits<double>::min() / (50.0 * epsilon)) error = std::max(50.0 * epsilon * resabs, error);
+            return Estimate{resk * half, error};
+        }
+
+        struct Options {
+            double abs_tolerance = 1e-10;
+            double rel_tolerance = 1e-10;  // względem |wyniku|; kończy, gdy błąd <= max(abs, rel * |I|)
+            size_t max_intervals = 1000;   // limit liczby podprzedziałów
+            Rule rule = Rule::G7K15;
+        };
+
+        struct Result {
+            double value = 0.0;
+            double error_estimate = 0.0;
+            size_t evaluations = 0;
+            size_t intervals = 0;
+            bool converged = false;
+        };
+
+        // Adaptacyjne całkowanie: zawsze dzielony jest na pół podprzedział o największym oszacowaniu
+        // błędu (kopiec), więc próbki trafiają tam, gdzie funkcja ma ostre cechy.
+        template <typename F>
+        Result integrate(F&& f, double a, double b, const Options& options = Options()) {
+            if (!(options.abs_tolerance >= 0.0) || !(options.rel_tolerance >= 0.0) ||
+                (options.abs_tolerance == 0.0 && options.rel_tolerance == 0.0) || options.max_intervals == 0) {
+                throw std::runtime_error("GaussKronrod::integrate: invalid tolerances or interval limit.");
+            }
+            if (!std::isfinite(a) || !std::isfinite(b)) {
+                throw std::runtime_error("GaussKronrod::integrate: integration limits must be finite.");
+            }
+            Result result;
+            if (a == b) {
+                result.converged = true;
+                return result;
+            }
+            const double sign = b < a ? -1.0 : 1.0;
+            if (b < a) std::swap(a, b);
+            const Nodes r = nodes(options.rule);
+            const size_t per_panel = static_cast<size_t>(2 * r.kronrod_half - 1);
+
+            struct Panel {
+                double a, b, value, error;
+            };
+            auto by_error = [](const Panel& p, const Panel& q) { return p.error < q.error; };
+            std::vector<Panel> heap;
+            heap.reserve(options.max_intervals + 1);
+            const Estimate first = estimate(f, r, a, b);
+            heap.push_back(Panel{a, b, first.value, first.error});
+            result.evaluations = per_panel;
+            double total = first.value, error = first.error;
+            auto tolerance = [&]() { return std::max(options.abs_tolerance, options.rel_tolerance * std::abs(total)); };
+
+            while (error > tolerance() && heap.size() < options.max_intervals) {
+                const Panel worst = heap.front();
+                const double mid = 0.5 * (worst.a + worst.b);
+                if (!(worst.a < mid && mid < worst.b)) break; // przedział nie do podzielenia w arytmetyce double
+                std::pop_heap(heap.begin(), heap.end(), by_error);
+                heap.pop_back();
+                const Estimate left = estimate(f, r, worst.a, mid);
+                const Estimate right = estimate(f, r, mid, worst.b);
+                result.evaluations += 2 * per_panel;
+                total += left.value + right.value - worst.value;
+                error += left.error + right.error - worst.error;
+                heap.push_back(Panel{worst.a, mid, left.value, left.error});
+                std::push_heap(heap.begin(), heap.end(), by_error);
+                heap.push_back(Panel{mid, worst.b, right.value, right.error});
+                std::push_heap(heap.begin(), heap.end(), by_error);
+            }
+
+            // Sumy od nowa - bez błędów zaokrągleń z aktualizacji przyrostowych
+            total = 0.0;
+            error = 0.0;
+            for (const Panel& p : heap) {
+                total += p.value;
+                error += p.error;
+            }
+            result.value = sign * total;
+            result.error_estimate = error;
+            result.intervals = heap.size();
+            result.converged = error <= tolerance();
+            return result;
+        }
+
+        Result integrate(IntegrableFunction f, double a, double b, const Options& options = Options());
+    } // namespace GaussKronrod
 } // namespace Integration
 } // namespace MeteoNumerical
 
-#endif // METEO_INTEGRATION_HPP
\ No newline at end of file
+#endif // METEO_INTEGRATION_HPP
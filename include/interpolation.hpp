@@ -2,7 +2,11 @@
 #define METEO_INTERPOLATION_HPP
 
 #include "common.hpp"
+#include "densematrix.hpp"
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace MeteoNumerical {
 namespace Interpolation {
@@ -11,10 +15,94 @@ namespace Interpolation {
         Common::Matrix calculateDividedDifferences(const Common::ValueSeries& x, const Common::ValueSeries& y);
         Common::ValueSeries getNewtonCoefficients(const Common::Matrix& divDiff);
         double newtonInterpolate(const Common::ValueSeries& x_nodes, const Common::ValueSeries& newton_coeffs, double xp);
+        // Wersja wsadowa: out[i] = p(xp[i]); zagnieżdżony Horner liczony dla bloków punktów w lanach SIMD.
+        void newtonInterpolateBatch(const Common::ValueSeries& x_nodes, const Common::ValueSeries& newton_coeffs,
+                               const double* xp, double* out, size_t count);
+
+        // Współczynniki Newtona (pierwszy wiersz tablicy różnic dzielonych) bez budowania tablicy n x n:
+        // kolejne kolumny tablicy nadpisują values od dołu, więc pamięć to O(n), a czas O(n^2).
+        void newtonCoefficientsInPlace(const Common::ValueSeries& x, Common::ValueSeries& values);
+        Common::ValueSeries newtonCoefficients(const Common::ValueSeries& x, const Common::ValueSeries& y);
+
+        // Wielomian Newtona rozbudowywany węzeł po węźle. Przechowywana jest tylko ostatnia przekątna
+        // tablicy różnic dzielonych f[x_k, ..., x_{n-1}], więc dodanie węzła kosztuje O(n) czasu
+        // i nie zmienia dotychczasowych współczynników.
+        class NewtonInterpolant {
+        public:
+            NewtonInterpolant() = default;
+            NewtonInterpolant(const Common::ValueSeries& x, const Common::ValueSeries& y);
+
+            void addNode(double x, double y);
+            void addNodes(const Common::ValueSeries& x, const Common::ValueSeries& y);
+            void clear();
+
+            double operator()(double x) const { return evaluate(x); }
+            double evaluate(double x) const;
+            void evaluate(const double* x, double* out, size_t count) const;
+            Common::ValueSeries evaluate(const Common::ValueSeries& x) const;
+
+            size_t size() const { return nodes_.size(); }
+            bool empty() const { return nodes_.empty(); }
+            const Common::ValueSeries& nodes() const { return nodes_; }
+            const Common::ValueSeries& coefficients() const { return coeffs_; }
+
+        private:
+            Common::ValueSeries nodes_;
+            Common::ValueSeries coeffs_;
+            Common::ValueSeries diagonal_; // diagonal_[k] = f[x_k, ..., x_{n-1}]
+        };
     } // namespace Newton
 
     namespace Lagrange {
         double lagrangeInterpolate(const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes, double xp);
+        // Wersja wsadowa: wagi barycentryczne liczone raz na wywołanie, potem O(n) na punkt (SIMD).
+        void lagrangeInterpolateBatch(const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes,
+                                 const double* xp, double* out, size_t count);
+
+        enum class ChebyshevKind {
+            FirstKind,  // zera T_n: cos((2j + 1) pi / 2n)
+            SecondKind  // ekstrema T_{n-1} (z końcami przedziału): cos(j pi / (n - 1))
+        };
+
+        // Węzły Czebyszewa przeskalowane na [a, b], rosnąco.
+        Common::ValueSeries chebyshevNodes(double a, double b, size_t n, ChebyshevKind kind = ChebyshevKind::SecondKind);
+
+        // Interpolacja Lagrange'a w postaci barycentrycznej (druga postać):
+        //   p(x) = sum_j w_j y_j / (x - x_j) / sum_j w_j / (x - x_j).
+        // Wagi w_j liczone są raz - w O(n^2) dla dowolnych węzłów (wtedy też jednorazowo sprawdzane są
+        // duplikaty) lub wzorem zamkniętym dla węzłów równoodległych i Czebyszewa - a każde wartościowanie
+        // kosztuje O(n). Wagi nie zależą od y, więc setValues() podmienia dane bez ich przeliczania.
+        class BarycentricInterpolator {
+        public:
+            BarycentricInterpolator() = default;
+            BarycentricInterpolator(const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes);
+
+            // y[j] to wartości w j-tym węźle równoodległym / węźle chebyshevNodes(a, b, y.size(), kind).
+            static BarycentricInterpolator equispaced(double a, double b, const Common::ValueSeries& y);
+            static BarycentricInterpolator chebyshev(double a, double b, const Common::ValueSeries& y,
+                                                     ChebyshevKind kind = ChebyshevKind::SecondKind);
+
+            void setValues(const Common::ValueSeries& y_nodes);
+
+            double operator()(double x) const { return evaluate(x); }
+            double evaluate(double x) const;
+            // Wartościowanie wielu punktów naraz: punkty są przetwarzane blokami w lanach SIMD.
+            void evaluate(const double* x, double* out, size_t count) const;
+            Common::ValueSeries evaluate(const Common::ValueSeries& x) const;
+
+            size_t size() const { return nodes_.size(); }
+            const Common::ValueSeries& nodes() const { return nodes_; }
+            const Common::ValueSeries& values() const { return values_; }
+            const Common::ValueSeries& weights() const { return weights_; }
+
+        private:
+            BarycentricInterpolator(Common::ValueSeries nodes, Common::ValueSeries weights, const Common::ValueSeries& y);
+            void requireValid(const char* where) const;
+
+            Common::ValueSeries nodes_;
+            Common::ValueSeries weights_;
+            Common::ValueSeries values_;
+        };
     } // namespace Lagrange
 
     void selectNodesByStep(const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
@@ -22,6 +110,32 @@ namespace Interpolation {
 
     using InterpolatorFunc = std::function<double(const Common::ValueSeries&, const Common::ValueSeries&, double)>;
 
+    // Wersja szablonowa dla dowolnego interpolatora punktowego (np. lambdy) - bez pośredniego
+    // wywołania std::function dla każdego punktu; wersja z InterpolatorFunc jest nakładką.
+    template <typename F, typename std::enable_if<std::is_invocable_r<double, F&, const Common::ValueSeries&,
+                                                                      const Common::ValueSeries&, double>::value,
+                                                  int>::type = 0>
+    double calculateInterpolationMSE(
+            const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
+            const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes_or_coeffs,
+            F&& interpolator,
+            Common::ValueSeries* out_mse_vector = nullptr,
+            Common::ValueSeries* out_x_error_points = nullptr) {
+        if (x_all.size() != y_all.size() || x_all.empty()) {
+            throw std::runtime_error("calculateInterpolationMSE: x_all and y_all are invalid.");
+        }
+        if (out_mse_vector) out_mse_vector->assign(x_all.size(), 0.0);
+        if (out_x_error_points) *out_x_error_points = x_all;
+        double total_mse_sum_sq_error = 0.0;
+        for (size_t i = 0; i < x_all.size(); ++i) {
+            double error = interpolator(x_nodes, y_nodes_or_coeffs, x_all[i]) - y_all[i];
+            double squared_error = error * error;
+            total_mse_sum_sq_error += squared_error;
+            if (out_mse_vector) (*out_mse_vector)[i] = squared_error;
+        }
+        return total_mse_sum_sq_error / static_cast<double>(x_all.size());
+    }
+
     double calculateInterpolationMSE(
             const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
             const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes_or_coeffs,
@@ -29,6 +143,42 @@ namespace Interpolation {
             Common::ValueSeries* out_mse_vector = nullptr,
             Common::ValueSeries* out_x_error_points = nullptr);
 
+    // Interpolator wsadowy: y[i] = p(x[i]) dla i < count, np. BarycentricInterpolator::evaluate.
+    using BatchInterpolatorFunc = std::function<void(const double* x, double* y, size_t count)>;
+
+    // Jak wyżej, ale cały zbiór punktów jest wartościowany jednym wywołaniem interpolatora.
+    double calculateInterpolationMSE(
+            const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
+            const BatchInterpolatorFunc& interpolator,
+            Common::ValueSeries* out_mse_vector = nullptr,
+            Common::ValueSeries* out_x_error_points = nullptr);
+
+    // Interpolant budowany z węzłów podanych widokami (np. co k-ty element x_all, bez kopiowania)
+    // i wartościowany wsadowo: out[i] = p(x[i]) dla i < count.
+    using NodeViewInterpolator = std::function<void(Common::ConstVectorView x_nodes, Common::ConstVectorView y_nodes,
+                                                    const double* x, double* out, size_t count)>;
+
+    struct NodeStepSweepOptions {
+        bool keep_point_errors = false; // zachowaj kwadraty błędów w każdym punkcie x_all
+        unsigned num_threads = 0;       // 0 = wszystkie rdzenie
+    };
+
+    struct NodeStepError {
+        unsigned k_step = 0;
+        size_t node_count = 0;
+        double mse = 0.0;
+        Common::ValueSeries squared_errors; // puste, gdy keep_point_errors == false
+    };
+
+    // Odpowiednik selectNodesByStep + calculateInterpolationMSE dla każdego k_step z [k_first, k_last]:
+    // węzły to widoki z krokiem k na x_all / y_all, a kandydaci są liczeni równolegle (najdroższe,
+    // czyli najmniejsze k, najpierw). Pusty interpolator oznacza wielomian interpolacyjny liczony
+    // w postaci barycentrycznej (O(m^2) na wagi, O(m) na punkt).
+    std::vector<NodeStepError> sweepNodeSteps(const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
+                                              unsigned k_first, unsigned k_last,
+                                              const NodeStepSweepOptions& options = NodeStepSweepOptions(),
+                                              const NodeViewInterpolator& interpolator = NodeViewInterpolator());
+
 } // namespace Interpolation
 } // namespace MeteoNumerical
 
@@ -2,25 +2,78 @@
 #define METEO_LINALG_HPP
 
 #include "common.hpp"
+#include "densematrix.hpp"
+#include "gemm.hpp"
+#include "lu.hpp"
+#include "cholesky.hpp"
+#include "qr.hpp"
 #include <iostream>
+#include <functional>
 
 namespace MeteoNumerical {
 namespace LinearAlgebra {
     void printMatrix(const Common::Matrix& matrix, std::ostream& os = std::cout, int precision = 5);
+    void printMatrix(Common::ConstMatrixView matrix, std::ostream& os = std::cout, int precision = 5);
     void printVector(const Common::ValueSeries& vec, std::ostream& os = std::cout, int precision = 5);
 
-    Common::ValueSeries gaussElimination(Common::Matrix A, Common::ValueSeries b);
+    // Stan eliminacji Gaussa po kroku k: wiersz pivot_row został zamieniony z k, a kolumna k
+    // wyzerowana pod przekątną. A i b to widoki na pamięć, na której pracuje eliminacja.
+    struct GaussStep {
+        size_t step;
+        size_t pivot_row;
+        double pivot;
+        Common::ConstMatrixView A;
+        Common::ConstVectorView b;
+    };
+    // Opcjonalny obserwator kroków - pusty oznacza brak jakiejkolwiek diagnostyki.
+    using GaussObserver = std::function<void(const GaussStep&)>;
+
+    // Eliminacja w miejscu na pamięci wywołującego: A zostaje zamieniona na macierz trójkątną górną,
+    // a b na rozwiązanie. Nie alokuje i nie wypisuje niczego.
+    void gaussEliminationInPlace(Common::MatrixView A, Common::VectorView b,
+                                 const GaussObserver& observer = GaussObserver());
+    void gaussEliminationInPlace(Common::MatrixView A, Common::ValueSeries& b,
+                                 const GaussObserver& observer = GaussObserver());
+    Common::ValueSeries gaussElimination(const Common::Matrix& A, const Common::ValueSeries& b,
+                                         const GaussObserver& observer = GaussObserver());
+    Common::ValueSeries gaussElimination(Common::ConstMatrixView A, const Common::ValueSeries& b,
+                                         const GaussObserver& observer = GaussObserver());
+    // Obserwator wypisujący macierz i prawą stronę po każdym kroku (dawne zachowanie diagnostyczne).
+    GaussObserver printingGaussObserver(std::ostream& os = std::cout, int precision = 4);
     
-    bool luDecompositionPivoting(const Common::Matrix& A, Common::Matrix& L, Common::Matrix& U, Common::IndexVector& P);
+    // diagnostics (opcjonalnie) dostaje estymatę uwarunkowania i wzrost elementów rozkładu.
+    bool luDecompositionPivoting(const Common::Matrix& A, Common::Matrix& L, Common::Matrix& U, Common::IndexVector& P,
+                                 FactorizationDiagnostics* diagnostics = nullptr);
+    bool luDecompositionPivoting(Common::ConstMatrixView A, Common::DenseMatrix& L, Common::DenseMatrix& U, Common::IndexVector& P,
+                                 FactorizationDiagnostics* diagnostics = nullptr);
     
     Common::ValueSeries permuteVector(const Common::ValueSeries& b, const Common::IndexVector& P);
     Common::ValueSeries forwardSubstitution(const Common::Matrix& L, const Common::ValueSeries& pb);
+    Common::ValueSeries forwardSubstitution(Common::ConstMatrixView L, const Common::ValueSeries& pb);
     Common::ValueSeries backwardSubstitution(const Common::Matrix& U, const Common::ValueSeries& y);
+    Common::ValueSeries backwardSubstitution(Common::ConstMatrixView U, const Common::ValueSeries& y);
+    
+    // Wersje dla wielu prawych stron naraz (kolumny B): rozwiązują L X = B / U X = B w miejscu,
+    // nadpisując B przez X. Domyślnie L ma jedynki na przekątnej, jak w forwardSubstitution.
+    enum class Diagonal { NonUnit, Unit };
+    void forwardSubstitutionInPlace(Common::ConstMatrixView L, Common::MatrixView B, Diagonal diag = Diagonal::Unit);
+    void backwardSubstitutionInPlace(Common::ConstMatrixView U, Common::MatrixView B, Diagonal diag = Diagonal::NonUnit);
     
     Common::ValueSeries solveWithLU(const Common::Matrix& A, const Common::ValueSeries& b);
+    Common::ValueSeries solveWithLU(Common::ConstMatrixView A, const Common::ValueSeries& b);
+    Common::DenseMatrix solveWithLU(Common::ConstMatrixView A, Common::ConstMatrixView B);
+
+    // Ogólny solwer: dla macierzy zadeklarowanej jako symetryczna dodatnio określona używa
+    // rozkładu LDL^T (czyta tylko dolny trójkąt), w pozostałych przypadkach LU z wyborem elementu.
+    enum class MatrixStructure { General, SymmetricPositiveDefinite };
+    Common::ValueSeries solve(const Common::Matrix& A, const Common::ValueSeries& b,
+                              MatrixStructure structure = MatrixStructure::General);
+    Common::ValueSeries solve(Common::ConstMatrixView A, const Common::ValueSeries& b,
+                              MatrixStructure structure = MatrixStructure::General);
 
     Common::Matrix multiplyMatrices(const Common::Matrix& A, const Common::Matrix& B);
+    Common::DenseMatrix multiplyMatrices(Common::ConstMatrixView A, Common::ConstMatrixView B);
 } // namespace LinearAlgebra
 } // namespace MeteoNumerical
 
-#endif // METEO_LINALG_HPP
\ No newline at end of file
+#endif // METEO_LINALG_HPP
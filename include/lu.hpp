@@ -0,0 +1,89 @@
+#ifndef METEO_LU_HPP
+#define METEO_LU_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include "condition.hpp"
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    // Parametry rozkładu blokowego: szerokość panelu i liczba wątków aktualizacji
+    // dopełnienia Schura (0 = wszystkie rdzenie). Panel jest dzielony rekurencyjnie, więc także
+    // dla n <= block_size większość pracy wykonuje GEMM.
+    struct LUOptions {
+        size_t block_size = 128;
+        unsigned num_threads = 0;
+    };
+
+    // Rozkład PA = LU z częściowym wyborem elementu głównego.
+    // L (bez jedynek na przekątnej) i U są przechowywane razem w jednej macierzy n x n,
+    // a pivots()[k] to numer wiersza zamienionego z wierszem k w kroku k.
+    // Obiekt rozkłada macierz raz i może rozwiązywać dowolną liczbę układów.
+    class LUFactorization {
+    public:
+        LUFactorization() = default;
+        explicit LUFactorization(Common::ConstMatrixView A, const LUOptions& options = LUOptions());
+        explicit LUFactorization(Common::DenseMatrix&& A, const LUOptions& options = LUOptions());
+        explicit LUFactorization(const Common::Matrix& A, const LUOptions& options = LUOptions());
+
+        // Zwracają false, gdy macierz jest osobliwa lub nie jest kwadratowa.
+        bool factor(Common::ConstMatrixView A, const LUOptions& options = LUOptions());
+        bool factor(Common::DenseMatrix&& A, const LUOptions& options = LUOptions());
+
+        bool isFactored() const { return factored_; }
+        size_t size() const { return lu_.rows(); }
+
+        const Common::DenseMatrix& packedLU() const { return lu_; }
+        const Common::IndexVector& pivots() const { return pivots_; }
+        Common::IndexVector permutation() const;
+        Common::DenseMatrix lower() const;
+        Common::DenseMatrix upper() const;
+
+        Common::ValueSeries solve(const Common::ValueSeries& b) const;
+        void solveInPlace(Common::ValueSeries& b) const;
+        // Wiele prawych stron naraz (kolumny B)
+        Common::DenseMatrix solve(Common::ConstMatrixView B) const;
+        void solveInPlace(Common::MatrixView B) const;
+        // A^T x = b
+        void solveTransposedInPlace(Common::ValueSeries& b) const;
+
+        double determinant() const;
+        // Estymata uwarunkowania i wzrost elementów w O(n^2), bez ponownego rozkładu
+        FactorizationDiagnostics diagnostics() const;
+
+    private:
+        void requireFactored(const char* where) const;
+
+        Common::DenseMatrix lu_;
+        Common::IndexVector pivots_;
+        double norm1_ = 0.0;   // ||A||_1 zapamiętane przed rozkładem
+        double max_abs_ = 0.0; // max|A_ij|
+        bool factored_ = false;
+    };
+
+    // Tryb mieszanej precyzji dla solveWithLU: rozkład LU w float, poprawianie iteracyjne
+    // z residuum liczonym w double. tolerance == 0 oznacza kryterium LAPACK (dsgesv):
+    // ||b - Ax||_inf <= sqrt(n) * eps * ||A||_inf * ||x||_inf.
+    struct MixedPrecisionOptions {
+        size_t max_refinement_steps = 30;
+        double tolerance = 0.0;
+        LUOptions lu;
+    };
+
+    struct MixedPrecisionResult {
+        Common::ValueSeries x;
+        size_t refinement_steps = 0;
+        bool used_double_fallback = false; // poprawianie nie zbiegło -> pełny rozkład w double
+        double backward_error = 0.0;       // ||b - Ax||_inf / (||A||_inf * ||x||_inf)
+        double condition_estimate = 0.0;   // estymata kappa_1(A) (estymator Hagera)
+    };
+
+    // Rzuca wyjątek, gdy macierz jest osobliwa także w podwójnej precyzji.
+    MixedPrecisionResult solveWithLU(Common::ConstMatrixView A, const Common::ValueSeries& b,
+                                     const MixedPrecisionOptions& options);
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_LU_HPP
@@ -5,12 +5,97 @@
 #include <functional>
 #include <vector>
 #include <string>
+#include <stdexcept>
+#include <cmath>
 
 namespace MeteoNumerical {
 namespace ODE {
     using ODEFunction = std::function<double(double t, double y)>;
     using ODESolution = std::vector<std::pair<double, double>>;
 
+    // Kroki i solve są szablonami przyjmującymi dowolny obiekt wywoływalny f(t, y) (wywołanie może
+    // zostać wstawione); wersje z ODEFunction są cienkimi nakładkami.
+    template <typename F>
+    double eulerStep(F&& func, double t_i, double y_i, double h) {
+        if (std::isnan(y_i)) return y_i;
+        return y_i + h * func(t_i, y_i);
+    }
+
+    template <typename F>
+    double heunStep(F&& func, double t_i, double y_i, double h) {
+        if (std::isnan(y_i)) return y_i;
+        double f_i = func(t_i, y_i);
+        double y_predictor = y_i + h * f_i;
+        if (std::isnan(y_predictor)) y_predictor = y_i;
+        return y_i + (h / 2.0) * (f_i + func(t_i + h, y_predictor));
+    }
+
+    template <typename F>
+    double midpointStep(F&& func, double t_i, double y_i, double h) {
+        if (std::isnan(y_i)) return y_i;
+        double y_mid_arg = y_i + (h / 2.0) * func(t_i, y_i);
+        if (std::isnan(y_mid_arg)) y_mid_arg = y_i;
+        return y_i + h * func(t_i + h / 2.0, y_mid_arg);
+    }
+
+    template <typename F>
+    double rk4Step(F&& func, double t_i, double y_i, double h) {
+        if (std::isnan(y_i)) return y_i;
+        double k1 = h * func(t_i, y_i);
+        double y_for_k2 = y_i + k1 / 2.0; if(std::isnan(y_for_k2)) y_for_k2 = y_i;
+        double k2 = h * func(t_i + h / 2.0, y_for_k2);
+        double y_for_k3 = y_i + k2 / 2.0; if(std::isnan(y_for_k3)) y_for_k3 = y_i;
+        double k3 = h * func(t_i + h / 2.0, y_for_k3);
+        double y_for_k4 = y_i + k3; if(std::isnan(y_for_k4)) y_for_k4 = y_i;
+        double k4 = h * func(t_i + h, y_for_k4);
+        return y_i + (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+    }
+
+    template <typename F>
+    ODESolution solve(F&& func, double t0, double y0, double t_final, double h,
+                      const std::string& method_name = "rk4") {
+        if (h == 0) throw std::runtime_error("ODE::solve: Step size h cannot be zero.");
+
+        enum class Method { Euler, Heun, Midpoint, RK4 } method;
+        if (method_name == "euler") method = Method::Euler;
+        else if (method_name == "heun") method = Method::Heun;
+        else if (method_name == "midpoint") method = Method::Midpoint;
+        else if (method_name == "rk4") method = Method::RK4;
+        else throw std::runtime_error("ODE::solve: Unknown method_name: " + method_name);
+
+        auto step = [&](double t, double y, double step_h) {
+            switch (method) {
+                case Method::Euler: return eulerStep<F&>(func, t, y, step_h);
+                case Method::Heun: return heunStep<F&>(func, t, y, step_h);
+                case Method::Midpoint: return midpointStep<F&>(func, t, y, step_h);
+                default: return rk4Step<F&>(func, t, y, step_h);
+            }
+        };
+
+        int num_steps = static_cast<int>(std::abs(t_final - t0) / std::abs(h));
+        ODESolution results;
+        results.reserve(static_cast<size_t>(num_steps) + 2);
+        double t = t0;
+        double y = y0;
+        results.push_back({t, y});
+
+        for(int i = 0; i < num_steps; ++i) {
+            y = step(t, y, h);
+            t += h;
+            results.push_back({t, y});
+        }
+
+        if (std::abs(t - t_final) > Common::DEFAULT_EPSILON) {
+             double last_h = t_final - t;
+             if (std::abs(last_h) > Common::DEFAULT_EPSILON / 100.0) {
+                y = step(t, y, last_h);
+                t = t_final;
+                results.push_back({t, y});
+             }
+        }
+        return results;
+    }
+
     double eulerStep(ODEFunction func, double t_i, double y_i, double h);
     double heunStep(ODEFunction func, double t_i, double y_i, double h);
     double midpointStep(ODEFunction func, double t_i, double y_i, double h);
@@ -0,0 +1,82 @@
+#ifndef METEO_PARALLEL_HPP
+#define METEO_PARALLEL_HPP
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <algorithm>
+#include <cstddef>
+
+namespace MeteoNumerical {
+namespace Common {
+
+    // Liczba wątków używana, gdy wywołujący poda 0.
+    inline unsigned defaultThreadCount() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1u : hw;
+    }
+
+    // Wywołuje body(lo, hi) dla kolejnych fragmentów [begin, end) o długości co najwyżej chunk.
+    // Fragmenty są rozdzielane dynamicznie między wątki; pierwszy wyjątek z wątku roboczego
+    // jest przekazywany do wywołującego. Dla num_threads == 0 używane jest defaultThreadCount().
+    template <typename Body>
+    void parallelForChunks(size_t begin, size_t end, size_t chunk, unsigned num_threads, Body&& body) {
+        if (end <= begin) return;
+        if (chunk == 0) chunk = 1;
+        const size_t num_chunks = (end - begin + chunk - 1) / chunk;
+        if (num_threads == 0) num_threads = defaultThreadCount();
+        const unsigned workers = static_cast<unsigned>(std::min<size_t>(num_threads, num_chunks));
+
+        if (workers <= 1) {
+            for (size_t lo = begin; lo < end; lo += chunk) body(lo, std::min(end, lo + chunk));
+            return;
+        }
+
+        std::atomic<size_t> next_chunk{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            try {
+                for (size_t c = next_chunk.fetch_add(1); c < num_chunks; c = next_chunk.fetch_add(1)) {
+                    size_t lo = begin + c * chunk;
+                    body(lo, std::min(end, lo + chunk));
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next_chunk.store(num_chunks);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (unsigned t = 1; t < workers; ++t) {
+            try {
+                threads.emplace_back(worker);
+            } catch (const std::system_error&) {
+                break; // brak zasobów na kolejny wątek - porcje przejmą wątki już uruchomione
+            }
+        }
+        worker(); // wątek wywołujący też pracuje
+        for (auto& th : threads) th.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Wywołuje body(i) dla każdego i z [begin, end).
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, unsigned num_threads, Body&& body) {
+        if (end <= begin) return;
+        if (num_threads == 0) num_threads = defaultThreadCount();
+        size_t chunk = std::max<size_t>(1, (end - begin) / (8 * static_cast<size_t>(num_threads)));
+        parallelForChunks(begin, end, chunk, num_threads, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) body(i);
+        });
+    }
+
+} // namespace Common
+} // namespace MeteoNumerical
+
+#endif // METEO_PARALLEL_HPP
@@ -0,0 +1,52 @@
+#ifndef METEO_PCA_HPP
+#define METEO_PCA_HPP
+
+#include "common.hpp"
+#include "datastructures.hpp"
+#include "densematrix.hpp"
+#include <vector>
+
+namespace MeteoNumerical {
+namespace Statistics {
+
+    enum class MeasurementField { Temperature, Humidity, Pressure, WindSpeed };
+
+    // Macierz danych: wiersz = chwila pomiaru, kolumna = pole (dla wielu stacji: stacja po stacji,
+    // w każdej pola w podanej kolejności). Serie stacji muszą mieć równą długość (wspólne chwile);
+    // wiersze z brakującą wartością (NaN) w którejkolwiek kolumnie są pomijane.
+    Common::DenseMatrix measurementMatrix(const DataStructures::MeasurementSeries& series,
+                                          const std::vector<MeasurementField>& fields);
+    Common::DenseMatrix measurementMatrix(const std::vector<DataStructures::MeasurementSeries>& stations,
+                                          const std::vector<MeasurementField>& fields);
+
+    struct PCAOptions {
+        size_t num_components = 0; // 0 = wszystkie
+        bool standardize = false;  // true: macierz korelacji (pola w różnych jednostkach)
+        unsigned num_threads = 0;
+        size_t lanczos_max_restarts = 500; // brak zbieżności Lanczosa = pełny rozkład
+    };
+
+    struct PCAResult {
+        Common::DenseMatrix components;               // p x k, kolumny = kierunki główne (jednostkowe)
+        Common::ValueSeries variances;                // wariancje składowych, malejąco
+        Common::ValueSeries explained_variance_ratio; // variances / całkowita wariancja
+        Common::ValueSeries mean;                     // średnie kolumn
+        Common::ValueSeries scale;                    // odchylenia standardowe (1 bez standaryzacji)
+        double total_variance = 0.0;
+    };
+
+    // Analiza składowych głównych macierzy danych (wiersze = obserwacje). Kowariancja jest liczona
+    // przez GEMM; dla kilku składowych z wielu kolumn używany jest Lanczos zamiast pełnego rozkładu.
+    // Znak każdej składowej jest ustalony tak, by jej największy co do modułu element był dodatni.
+    PCAResult principalComponents(Common::ConstMatrixView data, const PCAOptions& options = PCAOptions());
+    PCAResult principalComponents(const std::vector<DataStructures::MeasurementSeries>& stations,
+                                  const std::vector<MeasurementField>& fields,
+                                  const PCAOptions& options = PCAOptions());
+
+    // Współrzędne obserwacji w bazie składowych: ((data - mean) / scale) * components.
+    Common::DenseMatrix projectOntoComponents(const PCAResult& pca, Common::ConstMatrixView data);
+
+} // namespace Statistics
+} // namespace MeteoNumerical
+
+#endif // METEO_PCA_HPP
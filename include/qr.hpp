@@ -0,0 +1,101 @@
+#ifndef METEO_QR_HPP
+#define METEO_QR_HPP
+
+#include "common.hpp"
+#include "densematrix.hpp"
+#include <vector>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    // Szerokość bloku odbić (compact WY) i liczba wątków aktualizacji kolumn (0 = wszystkie rdzenie).
+    struct QROptions {
+        size_t block_size = 32;
+        unsigned num_threads = 0;
+    };
+
+    struct LeastSquaresResult {
+        Common::ValueSeries x;
+        double residual_norm = 0.0; // ||b - Ax||_2
+    };
+
+    // Blokowy rozkład Householdera A = QR macierzy m x n (m >= n).
+    // Wektory odbić leżą pod przekątną, R na i nad nią; dla każdego bloku odbić przechowywana jest
+    // macierz T postaci zwartej Q_blok = I - V T V^T, więc Q^T b liczy się dwoma mnożeniami GEMM.
+    class QRFactorization {
+    public:
+        QRFactorization() = default;
+        explicit QRFactorization(Common::ConstMatrixView A, const QROptions& options = QROptions());
+        explicit QRFactorization(const Common::Matrix& A, const QROptions& options = QROptions());
+
+        // false, gdy m < n lub macierz jest pusta
+        bool factor(Common::ConstMatrixView A, const QROptions& options = QROptions());
+
+        bool isFactored() const { return factored_; }
+        size_t rows() const { return qr_.rows(); }
+        size_t cols() const { return qr_.cols(); }
+        const Common::DenseMatrix& packedQR() const { return qr_; }
+        const Common::ValueSeries& tau() const { return tau_; }
+
+        Common::DenseMatrix R() const;       // n x n
+        Common::DenseMatrix thinQ() const;   // m x n, kolumny ortonormalne
+
+        void applyQTransposeInPlace(Common::ValueSeries& b) const;
+        void applyQTransposeInPlace(Common::MatrixView B) const;
+
+        // Rozwiązanie min ||Ax - b||_2; rzuca wyjątek, gdy R jest (numerycznie) osobliwa.
+        LeastSquaresResult solveLeastSquares(const Common::ValueSeries& b) const;
+        Common::DenseMatrix solveLeastSquares(Common::ConstMatrixView B) const;
+
+    private:
+        void requireFactored(const char* where) const;
+        void solveR(const char* where, Common::MatrixView X) const;
+
+        Common::DenseMatrix qr_;
+        Common::ValueSeries tau_;
+        std::vector<Common::DenseMatrix> t_blocks_;
+        size_t block_size_ = 0;
+        unsigned num_threads_ = 0;
+        bool factored_ = false;
+    };
+
+    // Przyrostowe najmniejsze kwadraty dla bardzo wysokich układów: wiersze [x | y] są dokładane
+    // porcjami, a przechowywana jest tylko trójkątna macierz (n+1) x (n+1) rozkładu QR macierzy
+    // rozszerzonej [A | b] = Q [R z; 0 rho]. Pamięć nie zależy od liczby obserwacji, a rho to
+    // norma residuum. Częściowe wyniki z różnych wątków łączy merge().
+    class IncrementalLeastSquares {
+    public:
+        explicit IncrementalLeastSquares(size_t num_predictors);
+
+        void addRow(const Common::ValueSeries& x, double y);
+        void addRows(Common::ConstMatrixView X, const Common::ValueSeries& y);
+        void merge(const IncrementalLeastSquares& other);
+
+        size_t predictors() const { return n_; }
+        size_t observations() const { return observations_; }
+        double residualNorm() const;
+        LeastSquaresResult solve() const;
+
+    private:
+        void flush();
+        void absorb(Common::ConstMatrixView rows);
+        Common::DenseMatrix currentR() const;
+
+        size_t n_;
+        size_t observations_ = 0;
+        Common::DenseMatrix r_;       // (n+1) x (n+1), trójkątna górna
+        Common::DenseMatrix pending_; // bufor pojedynczych wierszy [x | y]
+        size_t pending_rows_ = 0;
+    };
+
+    // min ||Ax - b||_2 dla A m x n (m >= n). Wysokie układy są dzielone na pasy wierszy
+    // rozkładane równolegle, których trójkątne czynniki są następnie łączone (TSQR).
+    LeastSquaresResult leastSquares(Common::ConstMatrixView A, const Common::ValueSeries& b,
+                                    const QROptions& options = QROptions());
+    LeastSquaresResult leastSquares(const Common::Matrix& A, const Common::ValueSeries& b,
+                                    const QROptions& options = QROptions());
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_QR_HPP
@@ -0,0 +1,30 @@
+#ifndef METEO_SIMD_HPP
+#define METEO_SIMD_HPP
+
+// Nagłówek wewnętrzny modułów liczących bloki danych wektorami rozszerzeń GCC.
+
+// Klony funkcji dla AVX-512/AVX2 wybierane w czasie ładowania (ifunc) - tylko x86 z ELF;
+// gdzie indziej funkcja jest kompilowana raz, dla architektury docelowej.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__)
+#define METEO_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define METEO_TARGET_CLONES
+#endif
+
+#include <cstddef>
+
+namespace MeteoNumerical {
+namespace Common {
+
+    // Liczba wartości liczonych naraz - jeden wektor AVX-512 (dwa AVX2, cztery SSE2).
+    constexpr size_t SIMD_LANES = 8;
+
+    // Wektory rozszerzeń GCC: kompilator sam dobiera instrukcje do architektury klonu funkcji.
+    // aligned(8) pozwala czytać je z buforów bez wyrównania do 64 bajtów.
+    typedef double LaneVec __attribute__((vector_size(SIMD_LANES * sizeof(double)), aligned(8)));
+    typedef long long LaneMask __attribute__((vector_size(SIMD_LANES * sizeof(long long)), aligned(8)));
+
+} // namespace Common
+} // namespace MeteoNumerical
+
+#endif // METEO_SIMD_HPP
@@ -0,0 +1,147 @@
+#ifndef METEO_SPARSE_HPP
+#define METEO_SPARSE_HPP
+
+#include "common.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+    struct Triplet {
+        size_t row;
+        size_t col;
+        double value;
+    };
+
+    class CSCMatrix;
+
+    // Macierz rzadka w formacie CSR (wiersze skompresowane); kolumny w wierszu są posortowane.
+    class CSRMatrix {
+    public:
+        CSRMatrix() = default;
+        CSRMatrix(size_t rows, size_t cols, std::vector<size_t> row_ptr,
+                  std::vector<size_t> col_idx, Common::ValueSeries values);
+
+        // Zduplikowane pozycje (row, col) są sumowane.
+        static CSRMatrix fromTriplets(size_t rows, size_t cols, const std::vector<Triplet>& triplets);
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t nonZeros() const { return values_.size(); }
+        const std::vector<size_t>& rowPointers() const { return row_ptr_; }
+        const std::vector<size_t>& columnIndices() const { return col_idx_; }
+        const Common::ValueSeries& values() const { return values_; }
+        Common::ValueSeries& values() { return values_; } // zmiana wartości bez zmiany struktury
+
+        double get(size_t i, size_t j) const;
+        Common::ValueSeries diagonal() const;
+
+        // y = A x; wiersze dzielone są między wątki (num_threads == 0 -> wszystkie rdzenie)
+        void multiply(const Common::ValueSeries& x, Common::ValueSeries& y, unsigned num_threads = 0) const;
+        Common::ValueSeries multiply(const Common::ValueSeries& x, unsigned num_threads = 0) const;
+
+        CSCMatrix toCSC() const;
+
+    private:
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        std::vector<size_t> row_ptr_ = {0};
+        std::vector<size_t> col_idx_;
+        Common::ValueSeries values_;
+    };
+
+    // Macierz rzadka w formacie CSC (kolumny skompresowane).
+    class CSCMatrix {
+    public:
+        CSCMatrix() = default;
+        CSCMatrix(size_t rows, size_t cols, std::vector<size_t> col_ptr,
+                  std::vector<size_t> row_idx, Common::ValueSeries values);
+
+        static CSCMatrix fromTriplets(size_t rows, size_t cols, const std::vector<Triplet>& triplets);
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t nonZeros() const { return values_.size(); }
+        const std::vector<size_t>& columnPointers() const { return col_ptr_; }
+        const std::vector<size_t>& rowIndices() const { return row_idx_; }
+        const Common::ValueSeries& values() const { return values_; }
+
+        Common::ValueSeries multiply(const Common::ValueSeries& x) const;
+        CSRMatrix toCSR() const;
+
+    private:
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        std::vector<size_t> col_ptr_ = {0};
+        std::vector<size_t> row_idx_;
+        Common::ValueSeries values_;
+    };
+
+    // --- Prekondycjonery: z = M^{-1} r ---
+    class Preconditioner {
+    public:
+        virtual ~Preconditioner() = default;
+        virtual void apply(const Common::ValueSeries& r, Common::ValueSeries& z) const = 0;
+    };
+
+    class IdentityPreconditioner : public Preconditioner {
+    public:
+        void apply(const Common::ValueSeries& r, Common::ValueSeries& z) const override;
+    };
+
+    class JacobiPreconditioner : public Preconditioner {
+    public:
+        explicit JacobiPreconditioner(const CSRMatrix& A);
+        void apply(const Common::ValueSeries& r, Common::ValueSeries& z) const override;
+
+    private:
+        Common::ValueSeries inv_diag_;
+    };
+
+    // Niepełny rozkład LU bez wypełnienia: L i U mają strukturę A.
+    class ILU0Preconditioner : public Preconditioner {
+    public:
+        explicit ILU0Preconditioner(const CSRMatrix& A);
+        void apply(const Common::ValueSeries& r, Common::ValueSeries& z) const override;
+
+    private:
+        CSRMatrix lu_;
+        std::vector<size_t> diag_pos_;
+    };
+
+    // --- Solwery iteracyjne ---
+    struct IterativeSolverOptions {
+        double tolerance = 1e-10;     // względna: ||b - Ax|| <= tolerance * ||b||
+        int max_iterations = 1000;
+        int restart = 30;             // tylko GMRES
+        unsigned num_threads = 0;     // wątki SpMV
+        Common::ValueSeries initial_guess; // pusty -> zera
+    };
+
+    struct IterativeSolverResult {
+        Common::ValueSeries x;
+        int iterations = 0;
+        bool converged = false;
+        double residual_norm = 0.0;
+        Common::ValueSeries residual_history; // ||r_k|| od iteracji 0
+    };
+
+    // Gradienty sprzężone dla macierzy symetrycznych dodatnio określonych.
+    IterativeSolverResult conjugateGradient(const CSRMatrix& A, const Common::ValueSeries& b,
+                                            const Preconditioner& preconditioner,
+                                            const IterativeSolverOptions& options = IterativeSolverOptions());
+    IterativeSolverResult conjugateGradient(const CSRMatrix& A, const Common::ValueSeries& b,
+                                            const IterativeSolverOptions& options = IterativeSolverOptions());
+
+    // GMRES(m) z restartem i prawostronnym prekondycjonowaniem (historia to norma residuum).
+    IterativeSolverResult gmres(const CSRMatrix& A, const Common::ValueSeries& b,
+                                const Preconditioner& preconditioner,
+                                const IterativeSolverOptions& options = IterativeSolverOptions());
+    IterativeSolverResult gmres(const CSRMatrix& A, const Common::ValueSeries& b,
+                                const IterativeSolverOptions& options = IterativeSolverOptions());
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
+
+#endif // METEO_SPARSE_HPP
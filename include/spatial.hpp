@@ -0,0 +1,97 @@
+#ifndef METEO_SPATIAL_HPP
+#define METEO_SPATIAL_HPP
+
+#include "common.hpp"
+#include "datastructures.hpp"
+#include "densematrix.hpp"
+#include <limits>
+#include <vector>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+    struct Neighbor {
+        size_t index;       // indeks stacji w danych wejściowych
+        double distance_sq; // kwadrat odległości od punktu zapytania
+    };
+
+    // Indeks k-d punktów na płaszczyźnie. Drzewo jest niejawne: punkty są permutowane tak, że mediana
+    // każdego zakresu leży w jego środku (bez wskaźników i alokacji węzłów), a podział następuje
+    // wzdłuż osi o większym rozrzucie. Zapytanie o k najbliższych kosztuje średnio O(k + log n).
+    class KDTree2D {
+    public:
+        KDTree2D() = default;
+        explicit KDTree2D(const std::vector<DataStructures::StationLocation>& points);
+
+        // Zapisuje min(k, size()) najbliższych punktów do out, rosnąco według odległości; nie alokuje.
+        size_t nearest(double x, double y, size_t k, Neighbor* out) const;
+        std::vector<Neighbor> nearest(double x, double y, size_t k) const;
+
+        size_t size() const { return points_.size(); }
+
+    private:
+        void build(const std::vector<DataStructures::StationLocation>& input, size_t lo, size_t hi);
+        void search(size_t lo, size_t hi, double x, double y, size_t k, Neighbor* out, size_t& count) const;
+
+        std::vector<DataStructures::StationLocation> points_; // w kolejności drzewa
+        std::vector<size_t> ids_;                              // indeksy wejściowe
+        std::vector<unsigned char> split_;                     // oś podziału (0 = x, 1 = y) w środku zakresu
+    };
+
+    enum class SpatialMethod {
+        InverseDistance, // wagi 1 / d^power (Shepard) z k najbliższych stacji
+        NaturalNeighbor  // wagi Laplace'a: długość wspólnej krawędzi komórki Voronoi / odległość
+    };
+
+    struct SpatialInterpolationOptions {
+        size_t neighbors = 12;    // liczba najbliższych stacji branych pod uwagę
+        double power = 2.0;       // wykładnik dla InverseDistance
+        double max_distance = std::numeric_limits<double>::infinity(); // dalsze stacje są pomijane
+        unsigned num_threads = 0; // dla fillGrid; 0 = wszystkie rdzenie
+    };
+
+    // Regularna siatka: węzeł (i, j) leży w (x0 + i * dx, y0 + j * dy); wynik fillGrid ma ny wierszy i nx kolumn.
+    struct RegularGrid2D {
+        double x0 = 0.0, y0 = 0.0;
+        double dx = 1.0, dy = 1.0;
+        size_t nx = 0, ny = 0;
+    };
+
+    // Interpolacja danych rozproszonych z sieci stacji. Drzewo k-d jest budowane raz; setValues()
+    // podmienia odczyty (np. kolejny termin pomiarowy) bez przebudowy. Każde zapytanie używa tylko
+    // k najbliższych stacji. NaturalNeighbor przycina komórkę Voronoi punktu zapytania dwusiecznymi
+    // do tych stacji, więc jest dokładny, gdy wszystkie naturalni sąsiedzi są wśród k najbliższych
+    // (odtwarza funkcje liniowe wewnątrz otoczki wypukłej). Gdy żadna stacja nie leży bliżej niż
+    // max_distance, wynikiem jest NaN.
+    class SpatialInterpolator {
+    public:
+        SpatialInterpolator(const std::vector<DataStructures::StationLocation>& stations,
+                            const Common::ValueSeries& values);
+
+        void setValues(const Common::ValueSeries& values);
+
+        double evaluate(double x, double y, SpatialMethod method = SpatialMethod::InverseDistance,
+                        const SpatialInterpolationOptions& options = SpatialInterpolationOptions()) const;
+        // Wypełnia całą siatkę; wiersze siatki są dzielone między wątki.
+        Common::DenseMatrix fillGrid(const RegularGrid2D& grid, SpatialMethod method = SpatialMethod::InverseDistance,
+                                     const SpatialInterpolationOptions& options = SpatialInterpolationOptions()) const;
+
+        const KDTree2D& index() const { return tree_; }
+        size_t size() const { return locations_.size(); }
+
+    private:
+        struct Scratch;
+        double evaluate(double x, double y, SpatialMethod method, const SpatialInterpolationOptions& options,
+                        Scratch& scratch) const;
+        double inverseDistance(const Neighbor* neighbors, size_t count, double power) const;
+        double naturalNeighbor(double x, double y, const Neighbor* neighbors, size_t count, Scratch& scratch) const;
+
+        std::vector<DataStructures::StationLocation> locations_;
+        Common::ValueSeries values_;
+        KDTree2D tree_;
+    };
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
+
+#endif // METEO_SPATIAL_HPP
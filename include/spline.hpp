@@ -0,0 +1,73 @@
+#ifndef METEO_SPLINE_HPP
+#define METEO_SPLINE_HPP
+
+#include "common.hpp"
+#include <vector>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+    enum class SplineBoundary {
+        Natural,  // S''(x_0) = S''(x_{n-1}) = 0
+        Clamped,  // zadane S'(x_0) i S'(x_{n-1})
+        NotAKnot  // ciągła S''' w x_1 i x_{n-2}
+    };
+
+    // Funkcja sklejana trzeciego stopnia. Momenty (drugie pochodne w węzłach) wyznacza jeden układ
+    // trójdiagonalny O(n); współczynniki każdego przedziału leżą obok siebie w pamięci.
+    // Przedział punktu jest znajdowany w O(1) dla siatki równomiernej, a w przeciwnym razie
+    // bezgałęziowym wyszukiwaniem binarnym. Poza [x_0, x_{n-1}] przedłużane są skrajne wielomiany.
+    class CubicSpline {
+    public:
+        CubicSpline() = default;
+        // left_slope / right_slope są używane tylko dla SplineBoundary::Clamped.
+        CubicSpline(const Common::ValueSeries& x, const Common::ValueSeries& y,
+                    SplineBoundary boundary = SplineBoundary::Natural,
+                    double left_slope = 0.0, double right_slope = 0.0);
+
+        // Węzły x_i = x0 + i * step (np. szereg czasowy o stałym kroku próbkowania).
+        static CubicSpline uniform(double x0, double step, const Common::ValueSeries& y,
+                                   SplineBoundary boundary = SplineBoundary::Natural,
+                                   double left_slope = 0.0, double right_slope = 0.0);
+
+        double operator()(double x) const { return evaluate(x); }
+        double evaluate(double x) const;
+        double derivative(double x) const;
+        double secondDerivative(double x) const;
+        // Całka oznaczona z S na [a, b] (a > b daje wynik ujemny); O(1) po znalezieniu przedziałów.
+        double integral(double a, double b) const;
+
+        // Wersje wsadowe; dla rosnących punktów kolejny przedział jest zwykle sąsiedni, więc
+        // wyszukiwanie jest pomijane.
+        void evaluate(const double* x, double* out, size_t count) const;
+        Common::ValueSeries evaluate(const Common::ValueSeries& x) const;
+        void derivative(const double* x, double* out, size_t count) const;
+
+        // Indeks i przedziału [x_i, x_{i+1}] zawierającego x (0 lub n-2 poza zakresem).
+        size_t findSegment(double x) const;
+
+        size_t size() const { return nodes_.size(); }
+        bool isUniform() const { return uniform_; }
+        const Common::ValueSeries& nodes() const { return nodes_; }
+
+    private:
+        // S(x) = a + b t + c t^2 + d t^3, t = x - x_i
+        struct Segment {
+            double x, a, b, c, d;
+        };
+
+        void build(const Common::ValueSeries& y, SplineBoundary boundary, double left_slope, double right_slope);
+        void requireBuilt(const char* where) const;
+        size_t nextSegment(size_t hint, double x) const;
+
+        Common::ValueSeries nodes_;
+        std::vector<Segment> segments_;
+        Common::ValueSeries cumulative_; // całka od x_0 do x_i
+        bool uniform_ = false;
+        double inv_step_ = 0.0;
+    };
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
+
+#endif // METEO_SPLINE_HPP
@@ -0,0 +1,62 @@
+#ifndef METEO_STREAMING_HPP
+#define METEO_STREAMING_HPP
+
+#include "common.hpp"
+#include <vector>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+    enum class StreamingScheme {
+        LocalCubic,  // wielomian 3. stopnia przez 4 próbki otaczające punkt (kawałkami)
+        WindowNewton // jeden wielomian Newtona przez wszystkie próbki okna (dla małych okien)
+    };
+
+    // Interpolacja w przesuwnym oknie ostatnich `window` próbek strumienia pomiarów.
+    // Próbki leżą w buforze cyklicznym zapisanym dwukrotnie (pozycje p i p + window), więc okno
+    // jest zawsze ciągłym fragmentem pamięci bez kopiowania. push() nie alokuje i kosztuje O(1)
+    // (LocalCubic) lub O(window) (WindowNewton - aktualizacja ilorazów różnicowych); zapytanie
+    // w oknie kosztuje O(1) dla próbek w przybliżeniu równoodległych (LocalCubic) lub O(window).
+    // Poza oknem wielomiany są ekstrapolowane.
+    class SlidingWindowInterpolator {
+    public:
+        explicit SlidingWindowInterpolator(size_t window, StreamingScheme scheme = StreamingScheme::LocalCubic);
+
+        // t musi być skończone i większe od czasu ostatniej próbki; pełne okno traci najstarszą próbkę.
+        void push(double t, double value);
+        void clear();
+
+        double operator()(double t) const { return evaluate(t); }
+        double evaluate(double t) const;
+        void evaluate(const double* t, double* out, size_t count) const;
+
+        size_t size() const { return count_; }
+        size_t capacity() const { return window_; }
+        bool full() const { return count_ == window_; }
+        StreamingScheme scheme() const { return scheme_; }
+        // i = 0 to najstarsza próbka okna
+        double timeAt(size_t i) const { return times_[head_ + i]; }
+        double valueAt(size_t i) const { return values_[head_ + i]; }
+        double oldestTime() const;
+        double newestTime() const;
+        bool contains(double t) const { return count_ > 0 && t >= oldestTime() && t <= newestTime(); }
+
+    private:
+        void requireSamples(const char* where) const;
+        size_t locate(double t, size_t hint) const;
+        double evaluateLocal(double t, size_t segment) const;
+        double evaluateNewton(double t) const;
+
+        size_t window_;
+        StreamingScheme scheme_;
+        std::vector<double> times_;  // 2 * window_
+        std::vector<double> values_; // 2 * window_
+        std::vector<double> newton_; // f[x_n], f[x_n, x_{n-1}], ... (od najnowszej próbki)
+        size_t head_ = 0;            // pozycja najstarszej próbki
+        size_t count_ = 0;
+    };
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
+
+#endif // METEO_STREAMING_HPP
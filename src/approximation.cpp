@@ -1,5 +1,5 @@
 #include "approximation.hpp"
-#include "linalg.hpp"       // Do rozwiązania układu równań (solveWithLU)
+#include "linalg.hpp"       // Do rozwiązania układu równań (LDL^T)
 #include <vector>
 #include <cmath>
 #include <stdexcept>
@@ -19,7 +19,8 @@ Common::ValueSeries polynomialApproximation(
         throw std::runtime_error("Stopień wielomianu musi być nieujemny.");
     }
 
-    Common::Matrix A(n, Common::ValueSeries(n));
+    // Macierz Grama jest symetryczna - liczymy tylko dolny trójkąt (j <= i)
+    Common::DenseMatrix A(n, n, 0.0);
     Common::ValueSeries b_vec(n);
 
     // Budowanie macierzy A i wektora b
@@ -32,17 +33,17 @@ Common::ValueSeries polynomialApproximation(
         b_vec[i] = Integration::GaussLegendre::composite(integrand_b, a, b, 4, integration_partitions);
 
         // Obliczanie macierzy A[i][j] = całka(x^(i+j))
-        for (int j = 0; j < n; ++j) {
+        for (int j = 0; j <= i; ++j) {
             auto integrand_A = [&](double x) {
                 return std::pow(x, i + j);
             };
-            A[i][j] = Integration::GaussLegendre::composite(integrand_A, a, b, 4, integration_partitions);
+            A(i, j) = Integration::GaussLegendre::composite(integrand_A, a, b, 4, integration_partitions);
         }
     }
 
     // Rozwiązanie układu równań liniowych A*coeffs = b_vec
-    // Używamy stabilnej funkcji solveWithLU z Twojej biblioteki
-    Common::ValueSeries coeffs = LinearAlgebra::solveWithLU(A, b_vec);
+    // Macierz Grama jest symetryczna dodatnio określona, więc wystarcza rozkład LDL^T
+    Common::ValueSeries coeffs = LinearAlgebra::solve(A, b_vec, LinearAlgebra::MatrixStructure::SymmetricPositiveDefinite);
 
     return coeffs;
 }
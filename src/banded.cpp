@@ -0,0 +1,228 @@
+#include "banded.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+Common::ValueSeries thomasSolve(const Common::ValueSeries& lower, const Common::ValueSeries& diag,
+                                const Common::ValueSeries& upper, const Common::ValueSeries& rhs) {
+    size_t n = diag.size();
+    if (n == 0 || rhs.size() != n || lower.size() + 1 != n || upper.size() + 1 != n) {
+        throw std::runtime_error("thomasSolve: Invalid diagonal or right-hand side sizes.");
+    }
+    Common::ValueSeries x = rhs;
+    Common::ValueSeries work(n);
+    thomasSolveInPlace(n, lower.data(), diag.data(), upper.data(), x.data(), work.data());
+    return x;
+}
+
+void thomasSolveInPlace(size_t n, const double* lower, const double* diag, const double* upper,
+                        double* rhs, double* work) {
+    if (n == 0) return;
+    if (std::abs(diag[0]) < Common::DEFAULT_EPSILON) {
+        throw std::runtime_error("thomasSolve: Zero pivot encountered.");
+    }
+    // work przechowuje zmodyfikowaną nad-przekątną c'
+    double denom = diag[0];
+    work[0] = n > 1 ? upper[0] / denom : 0.0;
+    rhs[0] /= denom;
+    for (size_t i = 1; i < n; ++i) {
+        denom = diag[i] - lower[i - 1] * work[i - 1];
+        if (std::abs(denom) < Common::DEFAULT_EPSILON) {
+            throw std::runtime_error("thomasSolve: Zero pivot encountered.");
+        }
+        work[i] = i + 1 < n ? upper[i] / denom : 0.0;
+        rhs[i] = (rhs[i] - lower[i - 1] * rhs[i - 1]) / denom;
+    }
+    for (size_t i = n - 1; i-- > 0;) {
+        rhs[i] -= work[i] * rhs[i + 1];
+    }
+}
+
+void thomasSolveBatched(size_t n, size_t batch, const double* lower, const double* diag,
+                        const double* upper, double* rhs, unsigned num_threads) {
+    if (n == 0 || batch == 0) return;
+    std::vector<double> work(n * batch);
+
+    // Każdy wątek rozwiązuje ciągły zakres układów [s0, s1)
+    Common::parallelForChunks(0, batch, 64, num_threads, [&](size_t s0, size_t s1) {
+        bool zero_pivot = false;
+        for (size_t s = s0; s < s1; ++s) {
+            double denom = diag[s];
+            zero_pivot |= std::abs(denom) < Common::DEFAULT_EPSILON;
+            work[s] = n > 1 ? upper[s] / denom : 0.0;
+            rhs[s] /= denom;
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const double* a = lower + (i - 1) * batch;
+            const double* b = diag + i * batch;
+            const double* c = upper + i * batch;
+            const double* w_prev = work.data() + (i - 1) * batch;
+            const double* d_prev = rhs + (i - 1) * batch;
+            double* w = work.data() + i * batch;
+            double* d = rhs + i * batch;
+            const bool last = (i + 1 == n);
+            for (size_t s = s0; s < s1; ++s) {
+                double den = b[s] - a[s] * w_prev[s];
+                zero_pivot |= std::abs(den) < Common::DEFAULT_EPSILON;
+                w[s] = last ? 0.0 : c[s] / den;
+                d[s] = (d[s] - a[s] * d_prev[s]) / den;
+            }
+        }
+        if (zero_pivot) {
+            throw std::runtime_error("thomasSolveBatched: Zero pivot encountered.");
+        }
+        for (size_t i = n - 1; i-- > 0;) {
+            const double* w = work.data() + i * batch;
+            const double* d_next = rhs + (i + 1) * batch;
+            double* d = rhs + i * batch;
+            for (size_t s = s0; s < s1; ++s) d[s] -= w[s] * d_next[s];
+        }
+    });
+}
+
+BandedMatrix::BandedMatrix(size_t n, size_t kl, size_t ku)
+        : n_(n), kl_(kl), ku_(ku), width_(2 * kl + ku + 1), data_(n * (2 * kl + ku + 1), 0.0) {}
+
+BandedMatrix BandedMatrix::fromDense(Common::ConstMatrixView A, size_t kl, size_t ku) {
+    if (A.rows() != A.cols()) {
+        throw std::runtime_error("BandedMatrix::fromDense: Matrix must be square.");
+    }
+    size_t n = A.rows();
+    BandedMatrix B(n, kl, ku);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (B.inBand(i, j)) B.raw(i, j) = A(i, j);
+            else if (A(i, j) != 0.0) {
+                throw std::runtime_error("BandedMatrix::fromDense: Nonzero element outside the band.");
+            }
+        }
+    }
+    return B;
+}
+
+double& BandedMatrix::at(size_t i, size_t j) {
+    if (i >= n_ || j >= n_ || !inBand(i, j)) {
+        throw std::out_of_range("BandedMatrix::at: Element outside the band.");
+    }
+    return raw(i, j);
+}
+
+double BandedMatrix::get(size_t i, size_t j) const {
+    if (i >= n_ || j >= n_ || !inBand(i, j)) return 0.0;
+    return raw(i, j);
+}
+
+Common::ValueSeries BandedMatrix::multiply(const Common::ValueSeries& x) const {
+    if (x.size() != n_) {
+        throw std::runtime_error("BandedMatrix::multiply: Vector size mismatch.");
+    }
+    Common::ValueSeries y(n_, 0.0);
+    for (size_t i = 0; i < n_; ++i) {
+        size_t j0 = i > kl_ ? i - kl_ : 0;
+        size_t j1 = std::min(n_ - 1, i + ku_);
+        double sum = 0.0;
+        for (size_t j = j0; j <= j1; ++j) sum += raw(i, j) * x[j];
+        y[i] = sum;
+    }
+    return y;
+}
+
+BandedLUFactorization::BandedLUFactorization(BandedMatrix A) {
+    if (!factor(std::move(A))) {
+        throw std::runtime_error("BandedLUFactorization: Matrix is singular.");
+    }
+}
+
+bool BandedLUFactorization::factor(BandedMatrix A) {
+    factored_ = false;
+    lu_ = std::move(A);
+    const size_t n = lu_.size();
+    if (n == 0) return false;
+    const size_t kl = lu_.lowerBandwidth();
+    const size_t ku_fill = lu_.upperBandwidth() + kl; // szerokość U po zamianach wierszy
+    pivots_.resize(n);
+
+    for (size_t k = 0; k < n; ++k) {
+        const size_t i_end = std::min(n - 1, k + kl);
+        const size_t j_end = std::min(n - 1, k + ku_fill);
+        size_t pivot_row = k;
+        double pivot_abs = std::abs(lu_.raw(k, k));
+        for (size_t i = k + 1; i <= i_end; ++i) {
+            double v = std::abs(lu_.raw(i, k));
+            if (v > pivot_abs) {
+                pivot_abs = v;
+                pivot_row = i;
+            }
+        }
+        if (pivot_abs < Common::DEFAULT_EPSILON) {
+            return false;
+        }
+        pivots_[k] = static_cast<int>(pivot_row);
+        if (pivot_row != k) {
+            for (size_t j = k; j <= j_end; ++j) std::swap(lu_.raw(k, j), lu_.raw(pivot_row, j));
+        }
+        const double inv_pivot = 1.0 / lu_.raw(k, k);
+        for (size_t i = k + 1; i <= i_end; ++i) {
+            const double l_ik = lu_.raw(i, k) * inv_pivot;
+            lu_.raw(i, k) = l_ik;
+            if (l_ik == 0.0) continue;
+            for (size_t j = k + 1; j <= j_end; ++j) {
+                lu_.raw(i, j) -= l_ik * lu_.raw(k, j);
+            }
+        }
+    }
+    factored_ = true;
+    return true;
+}
+
+Common::ValueSeries BandedLUFactorization::solve(const Common::ValueSeries& b) const {
+    Common::ValueSeries x = b;
+    solveInPlace(x);
+    return x;
+}
+
+void BandedLUFactorization::solveInPlace(Common::ValueSeries& b) const {
+    if (!factored_) {
+        throw std::runtime_error("BandedLUFactorization::solveInPlace: no valid factorization available.");
+    }
+    const size_t n = size();
+    if (b.size() != n) {
+        throw std::runtime_error("BandedLUFactorization::solveInPlace: right-hand side size mismatch.");
+    }
+    const size_t kl = lu_.lowerBandwidth();
+    const size_t ku_fill = lu_.upperBandwidth() + kl;
+    // L y = P b: zamiany i eliminacja przeplatają się tak jak w rozkładzie
+    for (size_t k = 0; k < n; ++k) {
+        std::swap(b[k], b[pivots_[k]]);
+        const size_t i_end = std::min(n - 1, k + kl);
+        for (size_t i = k + 1; i <= i_end; ++i) b[i] -= lu_.raw(i, k) * b[k];
+    }
+    for (size_t i = n; i-- > 0;) {
+        const size_t j_end = std::min(n - 1, i + ku_fill);
+        double sum = b[i];
+        for (size_t j = i + 1; j <= j_end; ++j) sum -= lu_.raw(i, j) * b[j];
+        b[i] = sum / lu_.raw(i, i);
+    }
+}
+
+void solveBandedBatched(const std::vector<BandedMatrix>& systems, std::vector<Common::ValueSeries>& rhs,
+                        unsigned num_threads) {
+    if (systems.size() != rhs.size()) {
+        throw std::runtime_error("solveBandedBatched: Number of systems and right-hand sides differ.");
+    }
+    Common::parallelFor(0, systems.size(), num_threads, [&](size_t s) {
+        BandedLUFactorization lu;
+        if (!lu.factor(systems[s])) {
+            throw std::runtime_error("solveBandedBatched: Singular system at index " + std::to_string(s) + ".");
+        }
+        lu.solveInPlace(rhs[s]);
+    });
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
@@ -0,0 +1,156 @@
+#include "batched.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+namespace {
+
+// Liczba układów rozwiązywanych naraz.
+constexpr size_t LANES = Common::SIMD_LANES;
+constexpr size_t MAX_FIXED_N = 10;
+// Liczba porcji po LANES układów przydzielanych wątkowi jednorazowo.
+constexpr size_t TILES_PER_TASK = 64;
+
+using Common::LaneVec;
+using Common::LaneMask;
+
+// a: n*n*LANES (element (i,j) lanu l pod (i*n + j)*LANES + l), rhs: n*LANES, nadpisywane rozwiązaniem.
+// Zamiany wierszy różnią się między lanami, więc są wykonywane przez maskowany wybór zamiast skoków.
+// Zwraca maskę bitową lanów z macierzą osobliwą.
+template <size_t N>
+__attribute__((always_inline)) inline unsigned solveTileBody(size_t n_runtime, double* a_ptr, double* rhs_ptr) {
+    const size_t n = N != 0 ? N : n_runtime;
+    LaneVec* a = reinterpret_cast<LaneVec*>(a_ptr);
+    LaneVec* rhs = reinterpret_cast<LaneVec*>(rhs_ptr);
+    const LaneVec zero = {};
+    LaneMask singular = {};
+
+    for (size_t k = 0; k < n; ++k) {
+        LaneVec best = a[k * n + k];
+        best = best < zero ? -best : best;
+        LaneVec pivot_row = zero + static_cast<double>(k);
+        for (size_t i = k + 1; i < n; ++i) {
+            LaneVec v = a[i * n + k];
+            v = v < zero ? -v : v;
+            const LaneMask better = v > best;
+            best = better ? v : best;
+            pivot_row = better ? zero + static_cast<double>(i) : pivot_row;
+        }
+        singular |= ~(best >= zero + Common::DEFAULT_EPSILON); // także NaN
+
+        for (size_t i = k + 1; i < n; ++i) {
+            const LaneMask swap = pivot_row == zero + static_cast<double>(i);
+            for (size_t j = k; j < n; ++j) {
+                const LaneVec top = a[k * n + j];
+                const LaneVec other = a[i * n + j];
+                a[k * n + j] = swap ? other : top;
+                a[i * n + j] = swap ? top : other;
+            }
+            const LaneVec top = rhs[k];
+            const LaneVec other = rhs[i];
+            rhs[k] = swap ? other : top;
+            rhs[i] = swap ? top : other;
+        }
+
+        const LaneVec inv_pivot = 1.0 / a[k * n + k];
+        for (size_t i = k + 1; i < n; ++i) {
+            const LaneVec f = a[i * n + k] * inv_pivot;
+            for (size_t j = k + 1; j < n; ++j) a[i * n + j] -= f * a[k * n + j];
+            rhs[i] -= f * rhs[k];
+        }
+    }
+
+    for (size_t i = n; i-- > 0;) {
+        LaneVec sum = rhs[i];
+        for (size_t j = i + 1; j < n; ++j) sum -= a[i * n + j] * rhs[j];
+        rhs[i] = sum / a[i * n + i];
+    }
+
+    unsigned mask = 0;
+    for (size_t l = 0; l < LANES; ++l) {
+        if (singular[l]) mask |= 1u << l;
+    }
+    return mask;
+}
+
+template <size_t N>
+METEO_TARGET_CLONES
+unsigned solveTileFixed(size_t, double* a, double* rhs) {
+    return solveTileBody<N>(N, a, rhs);
+}
+
+METEO_TARGET_CLONES
+unsigned solveTileDynamic(size_t n, double* a, double* rhs) {
+    return solveTileBody<0>(n, a, rhs);
+}
+
+using TileKernel = unsigned (*)(size_t, double*, double*);
+
+TileKernel selectTileKernel(size_t n) {
+    static const TileKernel fixed[MAX_FIXED_N + 1] = {
+        nullptr, solveTileFixed<1>, solveTileFixed<2>, solveTileFixed<3>, solveTileFixed<4>, solveTileFixed<5>,
+        solveTileFixed<6>, solveTileFixed<7>, solveTileFixed<8>, solveTileFixed<9>, solveTileFixed<10>};
+    return n <= MAX_FIXED_N ? fixed[n] : solveTileDynamic;
+}
+
+} // namespace
+
+size_t solveSmallSystemsBatched(size_t n, size_t batch,
+                                const double* A, size_t a_stride,
+                                const double* b, size_t b_stride,
+                                double* x, size_t x_stride,
+                                unsigned char* singular, unsigned num_threads) {
+    if (n == 0 || a_stride < n * n || b_stride < n || x_stride < n) {
+        throw std::runtime_error("solveSmallSystemsBatched: Invalid system size or strides.");
+    }
+    if (batch == 0) return 0;
+
+    const TileKernel kernel = selectTileKernel(n);
+    const size_t tiles = (batch + LANES - 1) / LANES;
+    std::atomic<size_t> singular_count{0};
+
+    Common::parallelForChunks(0, tiles, TILES_PER_TASK, num_threads, [&](size_t t_lo, size_t t_hi) {
+        std::vector<double> a_tile(n * n * LANES);
+        std::vector<double> rhs_tile(n * LANES);
+        size_t local_singular = 0;
+        for (size_t t = t_lo; t < t_hi; ++t) {
+            const size_t s0 = t * LANES;
+            const size_t lanes = std::min(LANES, batch - s0);
+            // Przepakowanie AoS -> SoA; puste lany ostatniej porcji dostają układ jednostkowy
+            for (size_t l = 0; l < lanes; ++l) {
+                const double* A_s = A + (s0 + l) * a_stride;
+                const double* b_s = b + (s0 + l) * b_stride;
+                for (size_t ij = 0; ij < n * n; ++ij) a_tile[ij * LANES + l] = A_s[ij];
+                for (size_t i = 0; i < n; ++i) rhs_tile[i * LANES + l] = b_s[i];
+            }
+            for (size_t l = lanes; l < LANES; ++l) {
+                for (size_t ij = 0; ij < n * n; ++ij) a_tile[ij * LANES + l] = (ij % (n + 1) == 0) ? 1.0 : 0.0;
+                for (size_t i = 0; i < n; ++i) rhs_tile[i * LANES + l] = 0.0;
+            }
+
+            const unsigned mask = kernel(n, a_tile.data(), rhs_tile.data());
+
+            for (size_t l = 0; l < lanes; ++l) {
+                const bool is_singular = (mask >> l) & 1u;
+                double* x_s = x + (s0 + l) * x_stride;
+                for (size_t i = 0; i < n; ++i) {
+                    x_s[i] = is_singular ? std::numeric_limits<double>::quiet_NaN() : rhs_tile[i * LANES + l];
+                }
+                if (singular != nullptr) singular[s0 + l] = is_singular ? 1 : 0;
+                local_singular += is_singular ? 1 : 0;
+            }
+        }
+        singular_count.fetch_add(local_singular, std::memory_order_relaxed);
+    });
+    return singular_count.load();
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
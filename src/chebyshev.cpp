@@ -0,0 +1,255 @@
+#include "chebyshev.hpp"
+#include "interpolation.hpp"
+#include "simd.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace MeteoNumerical {
+namespace Approximation {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+const size_t ADAPTIVE_START_POINTS = 17;
+
+bool isPowerOfTwo(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+// Iteracyjna FFT radix-2 w miejscu (n = 2^m); czynniki obrotu z tablicy, nie z mnożeń narastających.
+void fftRadix2(std::vector<Complex>& a, bool inverse) {
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    std::vector<Complex> twiddle(n / 2);
+    const double sign = inverse ? 1.0 : -1.0;
+    for (size_t k = 0; k < n / 2; ++k) twiddle[k] = std::polar(1.0, sign * 2.0 * M_PI * k / n);
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2, step = n / len;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t k = 0; k < half; ++k) {
+                const Complex u = a[i + k];
+                const Complex v = a[i + k + half] * twiddle[k * step];
+                a[i + k] = u + v;
+                a[i + k + half] = u - v;
+            }
+        }
+    }
+}
+
+// DFT dowolnej długości: radix-2 lub algorytm Bluesteina (splot przez FFT długości 2^m >= 2n - 1).
+void fft(std::vector<Complex>& a) {
+    const size_t n = a.size();
+    if (n <= 1) return;
+    if (isPowerOfTwo(n)) {
+        fftRadix2(a, false);
+        return;
+    }
+    size_t m = 1;
+    while (m < 2 * n - 1) m <<= 1;
+    std::vector<Complex> chirp(n), A(m), B(m);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t k2 = (k * k) % (2 * n); // k^2 mod 2n - dokładny argument także dla dużych k
+        chirp[k] = std::polar(1.0, -M_PI * static_cast<double>(k2) / n);
+        A[k] = a[k] * chirp[k];
+        B[k] = std::conj(chirp[k]);
+        if (k > 0) B[m - k] = B[k];
+    }
+    fftRadix2(A, false);
+    fftRadix2(B, false);
+    for (size_t k = 0; k < m; ++k) A[k] *= B[k];
+    fftRadix2(A, true);
+    for (size_t k = 0; k < n; ++k) a[k] = chirp[k] * A[k] / static_cast<double>(m);
+}
+
+using Common::SIMD_LANES;
+using Common::LaneVec;
+
+// Clenshaw dla pełnych bloków punktów; y = scale * x - shift.
+METEO_TARGET_CLONES
+void clenshawBlocks(const double* c, size_t n, double scale, double shift, const double* x, double* out,
+                    size_t blocks) {
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        LaneVec xv;
+        std::memcpy(&xv, x + blk * SIMD_LANES, sizeof(xv));
+        const LaneVec y = xv * scale - shift;
+        const LaneVec y2 = y + y;
+        LaneVec b1 = {}, b2 = {};
+        for (size_t k = n - 1; k >= 1; --k) {
+            const LaneVec b0 = y2 * b1 - b2 + c[k];
+            b2 = b1;
+            b1 = b0;
+        }
+        const LaneVec result = y * b1 - b2 + c[0];
+        std::memcpy(out + blk * SIMD_LANES, &result, sizeof(result));
+    }
+}
+
+} // namespace
+
+ChebyshevSeries::ChebyshevSeries(double a, double b, const Common::ValueSeries& coefficients)
+        : a_(a), b_(b), coeffs_(coefficients) {
+    if (!(a < b)) {
+        throw std::runtime_error("ChebyshevSeries: interval must satisfy a < b.");
+    }
+    if (coeffs_.empty()) {
+        throw std::runtime_error("ChebyshevSeries: coefficient vector is empty.");
+    }
+}
+
+Common::ValueSeries ChebyshevSeries::points(double a, double b, size_t n) {
+    return Interpolation::Lagrange::chebyshevNodes(a, b, n, Interpolation::Lagrange::ChebyshevKind::SecondKind);
+}
+
+ChebyshevSeries ChebyshevSeries::fromValues(double a, double b, const Common::ValueSeries& values) {
+    if (!(a < b) || values.empty()) {
+        throw std::runtime_error("ChebyshevSeries::fromValues: invalid interval or empty values.");
+    }
+    const size_t n = values.size();
+    if (n == 1) return ChebyshevSeries(a, b, values);
+
+    // DCT-I jako FFT parzystego przedłużenia długości 2N; f_j = f(cos(pi j / N)), czyli
+    // wartości w odwrotnej kolejności niż rosnące points().
+    const size_t N = n - 1;
+    std::vector<Complex> v(2 * N);
+    for (size_t j = 0; j <= N; ++j) v[j] = values[N - j];
+    for (size_t j = 1; j < N; ++j) v[2 * N - j] = values[N - j];
+    fft(v);
+    Common::ValueSeries c(n);
+    for (size_t k = 0; k <= N; ++k) c[k] = v[k].real() / static_cast<double>(N);
+    c[0] *= 0.5;
+    c[N] *= 0.5;
+    return ChebyshevSeries(a, b, c);
+}
+
+ChebyshevSeries ChebyshevSeries::interpolate(const Integration::IntegrableFunction& f, double a, double b, size_t n) {
+    if (!f) {
+        throw std::runtime_error("ChebyshevSeries::interpolate: function is empty.");
+    }
+    Common::ValueSeries x = points(a, b, n);
+    for (double& xi : x) xi = f(xi);
+    return fromValues(a, b, x);
+}
+
+ChebyshevSeries ChebyshevSeries::adaptive(const Integration::IntegrableFunction& f, double a, double b,
+                                          double tolerance, size_t max_points, bool* converged) {
+    if (!f) {
+        throw std::runtime_error("ChebyshevSeries::adaptive: function is empty.");
+    }
+    if (!(tolerance > 0.0)) {
+        throw std::runtime_error("ChebyshevSeries::adaptive: tolerance must be positive.");
+    }
+    auto sample = [&](double x) {
+        const double value = f(x);
+        if (!std::isfinite(value)) {
+            throw std::runtime_error("ChebyshevSeries::adaptive: function returned a non-finite value.");
+        }
+        return value;
+    };
+
+    size_t n = ADAPTIVE_START_POINTS;
+    Common::ValueSeries values = points(a, b, n);
+    for (double& v : values) v = sample(v);
+    for (;;) {
+        ChebyshevSeries series = fromValues(a, b, values);
+        const Common::ValueSeries& c = series.coeffs_;
+        double scale = 0.0;
+        for (double ck : c) scale = std::max(scale, std::abs(ck));
+        const size_t tail = std::max<size_t>(2, n / 8);
+        double tail_max = 0.0;
+        for (size_t k = n - tail; k < n; ++k) tail_max = std::max(tail_max, std::abs(c[k]));
+        const bool done = tail_max <= tolerance * scale;
+        if (done || 2 * n - 1 > max_points) {
+            if (converged) *converged = done;
+            series.truncate(tolerance);
+            return series;
+        }
+        // Punkty siatki 2N zawierają punkty siatki N na parzystych pozycjach.
+        const size_t next = 2 * n - 1;
+        const Common::ValueSeries x = points(a, b, next);
+        Common::ValueSeries refined(next);
+        for (size_t i = 0; i < next; ++i) refined[i] = i % 2 == 0 ? values[i / 2] : sample(x[i]);
+        values.swap(refined);
+        n = next;
+    }
+}
+
+void ChebyshevSeries::truncate(double tolerance) {
+    requireValid("ChebyshevSeries::truncate");
+    double scale = 0.0;
+    for (double ck : coeffs_) scale = std::max(scale, std::abs(ck));
+    const double threshold = tolerance * scale;
+    size_t keep = coeffs_.size();
+    while (keep > 1 && std::abs(coeffs_[keep - 1]) <= threshold) --keep;
+    coeffs_.resize(keep);
+}
+
+void ChebyshevSeries::requireValid(const char* where) const {
+    if (coeffs_.empty()) {
+        throw std::runtime_error(std::string(where) + ": series has no coefficients.");
+    }
+}
+
+double ChebyshevSeries::evaluate(double x) const {
+    requireValid("ChebyshevSeries::evaluate");
+    const double y = (2.0 * x - a_ - b_) / (b_ - a_);
+    double b1 = 0.0, b2 = 0.0;
+    for (size_t k = coeffs_.size() - 1; k >= 1; --k) {
+        const double b0 = 2.0 * y * b1 - b2 + coeffs_[k];
+        b2 = b1;
+        b1 = b0;
+    }
+    return y * b1 - b2 + coeffs_[0];
+}
+
+void ChebyshevSeries::evaluate(const double* x, double* out, size_t count) const {
+    requireValid("ChebyshevSeries::evaluate");
+    const double scale = 2.0 / (b_ - a_);
+    const double shift = (a_ + b_) / (b_ - a_);
+    const size_t blocks = count / SIMD_LANES;
+    clenshawBlocks(coeffs_.data(), coeffs_.size(), scale, shift, x, out, blocks);
+    for (size_t i = blocks * SIMD_LANES; i < count; ++i) out[i] = evaluate(x[i]);
+}
+
+Common::ValueSeries ChebyshevSeries::evaluate(const Common::ValueSeries& x) const {
+    Common::ValueSeries out(x.size());
+    evaluate(x.data(), out.data(), x.size());
+    return out;
+}
+
+ChebyshevSeries ChebyshevSeries::derivative() const {
+    requireValid("ChebyshevSeries::derivative");
+    const size_t n = coeffs_.size();
+    if (n == 1) return ChebyshevSeries(a_, b_, Common::ValueSeries{0.0});
+    // d_{k-1} = d_{k+1} + 2k c_k, d_0 połowione; czynnik 2 / (b - a) z zamiany zmiennych.
+    Common::ValueSeries d(n + 1, 0.0);
+    for (size_t k = n - 1; k >= 1; --k) d[k - 1] = d[k + 1] + 2.0 * static_cast<double>(k) * coeffs_[k];
+    d[0] *= 0.5;
+    d.resize(n - 1);
+    const double scale = 2.0 / (b_ - a_);
+    for (double& dk : d) dk *= scale;
+    return ChebyshevSeries(a_, b_, d);
+}
+
+double ChebyshevSeries::definiteIntegral() const {
+    requireValid("ChebyshevSeries::definiteIntegral");
+    // całka z T_k na [-1, 1]: 2 / (1 - k^2) dla parzystych k, 0 dla nieparzystych
+    double sum = 0.0;
+    for (size_t k = 0; k < coeffs_.size(); k += 2) {
+        sum += coeffs_[k] * 2.0 / (1.0 - static_cast<double>(k * k));
+    }
+    return 0.5 * (b_ - a_) * sum;
+}
+
+} // namespace Approximation
+} // namespace MeteoNumerical
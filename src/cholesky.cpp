@@ -0,0 +1,198 @@
+#include "cholesky.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+LDLTFactorization::LDLTFactorization(Common::ConstMatrixView A, const LDLTOptions& options) {
+    if (!factor(A, options)) {
+        throw std::runtime_error("LDLTFactorization: Matrix is not positive definite or not square.");
+    }
+}
+
+LDLTFactorization::LDLTFactorization(const Common::Matrix& A, const LDLTOptions& options)
+        : LDLTFactorization(Common::DenseMatrix(A), options) {}
+
+// Rozkład blokowy: panel [j0, j0+nb) liczony jest nieblokowo, a dolny trójkąt dopełnienia
+// A22 -= L21 * D1 * L21^T aktualizowany jest kolumnami bloków równolegle przez GEMM.
+bool LDLTFactorization::factor(Common::ConstMatrixView A, const LDLTOptions& options) {
+    factored_ = false;
+    const size_t n = A.rows();
+    if (n == 0 || A.cols() != n) return false;
+    ld_ = Common::DenseMatrix(n, n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(A.rowPtr(i), A.rowPtr(i) + i + 1, ld_.rowPtr(i)); // tylko dolny trójkąt
+    }
+    // ||A||_1 i max|A_ij| z dolnego trójkąta (A symetryczna)
+    Common::ValueSeries col_sums(n, 0.0);
+    max_abs_ = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            const double v = std::abs(ld_(i, j));
+            col_sums[j] += v;
+            if (j != i) col_sums[i] += v;
+            max_abs_ = std::max(max_abs_, v);
+        }
+    }
+    norm1_ = *std::max_element(col_sums.begin(), col_sums.end());
+    const size_t nb = std::max<size_t>(1, options.block_size);
+    Common::DenseMatrix W; // L21 * D1
+
+    for (size_t j0 = 0; j0 < n; j0 += nb) {
+        const size_t jb = std::min(nb, n - j0);
+        if (!factorPanel(j0, jb)) return false;
+        const size_t j1 = j0 + jb;
+        if (j1 == n) break;
+        const size_t rest = n - j1;
+
+        W = Common::DenseMatrix(rest, jb);
+        for (size_t i = 0; i < rest; ++i) {
+            const double* l_row = ld_.rowPtr(j1 + i) + j0;
+            double* w_row = W.rowPtr(i);
+            for (size_t k = 0; k < jb; ++k) w_row[k] = l_row[k] * ld_(j0 + k, j0 + k);
+        }
+        Common::ConstMatrixView L21 = ld_.block(j1, j0, rest, jb);
+        const size_t col_blocks = (rest + nb - 1) / nb;
+        Common::parallelFor(0, col_blocks, options.num_threads, [&](size_t cb) {
+            const size_t c0 = cb * nb;
+            const size_t cw = std::min(nb, rest - c0);
+            gemm(Transpose::No, Transpose::Yes, -1.0,
+                 W.block(c0, 0, rest - c0, jb), L21.block(c0, 0, cw, jb),
+                 1.0, ld_.block(j1 + c0, j1 + c0, rest - c0, cw));
+        });
+    }
+    // Blok przekątny jest aktualizowany w całości - czyścimy śmieci nad przekątną
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(ld_.rowPtr(i) + i + 1, ld_.rowPtr(i) + n, 0.0);
+    }
+    factored_ = true;
+    return true;
+}
+
+bool LDLTFactorization::factorPanel(size_t j0, size_t jb) {
+    const size_t n = ld_.rows();
+    const size_t j1 = j0 + jb;
+    for (size_t k = j0; k < j1; ++k) {
+        const double d_k = ld_(k, k);
+        if (!(d_k >= Common::DEFAULT_EPSILON)) { // także NaN
+            return false;
+        }
+        const double inv_d = 1.0 / d_k;
+        for (size_t i = k + 1; i < n; ++i) {
+            double* row_i = ld_.rowPtr(i);
+            const double a_ik = row_i[k];     // = l_ik * d_k
+            row_i[k] = a_ik * inv_d;
+            // a(i, j) -= l_ik * d_k * l_jk dla kolumn panelu k < j <= min(i, j1-1)
+            const size_t j_end = std::min(i + 1, j1);
+            for (size_t j = k + 1; j < j_end; ++j) {
+                row_i[j] -= a_ik * ld_(j, k);
+            }
+        }
+    }
+    return true;
+}
+
+void LDLTFactorization::requireFactored(const char* where) const {
+    if (!factored_) {
+        throw std::runtime_error(std::string(where) + ": no valid factorization available.");
+    }
+}
+
+Common::ValueSeries LDLTFactorization::diagonalD() const {
+    requireFactored("LDLTFactorization::diagonalD");
+    Common::ValueSeries d(size());
+    for (size_t i = 0; i < d.size(); ++i) d[i] = ld_(i, i);
+    return d;
+}
+
+Common::ValueSeries LDLTFactorization::solve(const Common::ValueSeries& b) const {
+    Common::ValueSeries x = b;
+    solveInPlace(x);
+    return x;
+}
+
+void LDLTFactorization::solveInPlace(Common::ValueSeries& b) const {
+    requireFactored("LDLTFactorization::solveInPlace");
+    const size_t n = size();
+    if (b.size() != n) {
+        throw std::runtime_error("LDLTFactorization::solveInPlace: right-hand side size mismatch.");
+    }
+    // L y = b
+    for (size_t i = 1; i < n; ++i) {
+        const double* row_i = ld_.rowPtr(i);
+        double sum = b[i];
+        for (size_t j = 0; j < i; ++j) sum -= row_i[j] * b[j];
+        b[i] = sum;
+    }
+    // D z = y
+    for (size_t i = 0; i < n; ++i) b[i] /= ld_(i, i);
+    // L^T x = z (kolumnowo, by czytać L wierszami)
+    for (size_t i = n; i-- > 1;) {
+        const double* row_i = ld_.rowPtr(i);
+        const double x_i = b[i];
+        for (size_t j = 0; j < i; ++j) b[j] -= row_i[j] * x_i;
+    }
+}
+
+Common::DenseMatrix LDLTFactorization::solve(Common::ConstMatrixView B) const {
+    Common::DenseMatrix X(B);
+    solveInPlace(X.view());
+    return X;
+}
+
+void LDLTFactorization::solveInPlace(Common::MatrixView B) const {
+    requireFactored("LDLTFactorization::solveInPlace");
+    const size_t n = size();
+    if (B.rows() != n) {
+        throw std::runtime_error("LDLTFactorization::solveInPlace: right-hand side size mismatch.");
+    }
+    forwardSubstitutionInPlace(ld_, B, Diagonal::Unit);
+    for (size_t i = 0; i < n; ++i) {
+        const double inv_d = 1.0 / ld_(i, i);
+        double* row = B.rowPtr(i);
+        for (size_t c = 0; c < B.cols(); ++c) row[c] *= inv_d;
+    }
+    // L^T X = Z: wiersz i rozwiązania odejmowany od wierszy j < i
+    for (size_t i = n; i-- > 1;) {
+        const double* l_row = ld_.rowPtr(i);
+        const double* x_i = B.rowPtr(i);
+        for (size_t j = 0; j < i; ++j) {
+            const double l_ij = l_row[j];
+            double* x_j = B.rowPtr(j);
+            for (size_t c = 0; c < B.cols(); ++c) x_j[c] -= l_ij * x_i[c];
+        }
+    }
+}
+
+FactorizationDiagnostics LDLTFactorization::diagnostics() const {
+    requireFactored("LDLTFactorization::diagnostics");
+    const size_t n = size();
+    FactorizationDiagnostics result;
+    result.norm1 = norm1_;
+    auto solve = [this](Common::ValueSeries& x) { solveInPlace(x); };
+    setConditionEstimate(result, estimateInverseNorm1(n, solve, solve));
+    // U = D L^T: elementy d_k oraz l_ik * d_k
+    double max_u = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double* row = ld_.rowPtr(i);
+        for (size_t k = 0; k < i; ++k) max_u = std::max(max_u, std::abs(row[k] * ld_(k, k)));
+        max_u = std::max(max_u, std::abs(row[i]));
+    }
+    result.pivot_growth = max_abs_ > 0.0 ? max_u / max_abs_ : 0.0;
+    return result;
+}
+
+double LDLTFactorization::determinant() const {
+    requireFactored("LDLTFactorization::determinant");
+    double det = 1.0;
+    for (size_t i = 0; i < size(); ++i) det *= ld_(i, i);
+    return det;
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
@@ -0,0 +1,43 @@
+#include "common.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MeteoNumerical {
+namespace Common {
+
+namespace {
+
+// Horner dla pełnych bloków SIMD_LANES punktów; resztę liczy wywołujący.
+METEO_TARGET_CLONES
+void hornerBlocks(const double* coeffs, size_t n, const double* x, double* out, size_t blocks) {
+    for (size_t b = 0; b < blocks; ++b) {
+        LaneVec xv;
+        std::memcpy(&xv, x + b * SIMD_LANES, sizeof(xv));
+        LaneVec r = {};
+        r += coeffs[n - 1];
+        for (size_t i = n - 1; i-- > 0;) r = r * xv + coeffs[i];
+        std::memcpy(out + b * SIMD_LANES, &r, sizeof(r));
+    }
+}
+
+} // namespace
+
+void evaluatePolynomialHornerBatch(const ValueSeries& coefficients, const double* x, double* out, size_t count) {
+    if (coefficients.empty()) {
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+    const size_t blocks = count / SIMD_LANES;
+    hornerBlocks(coefficients.data(), coefficients.size(), x, out, blocks);
+    for (size_t i = blocks * SIMD_LANES; i < count; ++i) out[i] = evaluatePolynomialHorner(coefficients, x[i]);
+}
+
+ValueSeries evaluatePolynomialHornerBatch(const ValueSeries& coefficients, const ValueSeries& x) {
+    ValueSeries out(x.size());
+    evaluatePolynomialHornerBatch(coefficients, x.data(), out.data(), x.size());
+    return out;
+}
+
+} // namespace Common
+} // namespace MeteoNumerical
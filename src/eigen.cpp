@@ -0,0 +1,399 @@
+#include "eigen.hpp"
+#include "gemm.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <limits>
+#include <cmath>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+namespace {
+
+// Maksymalna liczba przejść QR na jedną wartość własną (jak w LAPACK dsteqr).
+const int QR_MAX_ITERATIONS = 30;
+// Poniżej tylu elementów aktualizacji nie opłaca się uruchamiać wątków.
+const size_t PARALLEL_MIN_WORK = 1u << 16;
+const size_t ROW_CHUNK = 64;
+
+inline double dotProduct(const double* a, const double* b, size_t n) {
+    double acc[8] = {};
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        for (size_t q = 0; q < 8; ++q) acc[q] += a[j + q] * b[j + q];
+    }
+    double sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    for (; j < n; ++j) sum += a[j] * b[j];
+    return sum;
+}
+
+inline void axpy(double alpha, const double* x, double* y, size_t n) {
+    for (size_t j = 0; j < n; ++j) y[j] += alpha * x[j];
+}
+
+unsigned threadsFor(size_t work, unsigned num_threads) {
+    return work < PARALLEL_MIN_WORK ? 1u : num_threads;
+}
+
+// Redukcja A = Q T Q^T (jak LAPACK dsytd2). A jest pełną symetryczną kopią; w kroku k odbicie
+// H_k = I - tau v v^T zeruje wiersz k za naddiagonalą, a podmacierz końcowa dostaje aktualizację
+// rzędu 2: B -= v w^T + w v^T. Wektor v (bez v_0 = 1) zostaje w wierszu k za naddiagonalą.
+void tridiagonalize(Common::DenseMatrix& a, Common::ValueSeries& d, Common::ValueSeries& e,
+                    Common::ValueSeries& tau, unsigned num_threads) {
+    const size_t n = a.rows();
+    d.assign(n, 0.0);
+    e.assign(n, 0.0);
+    tau.assign(n, 0.0);
+    if (n == 0) return;
+
+    Common::ValueSeries v(n), p(n);
+    for (size_t k = 0; k + 2 < n; ++k) {
+        const size_t m = n - k - 1;
+        double* x = a.rowPtr(k) + k + 1;
+        d[k] = a(k, k);
+        const double alpha = x[0];
+        double sigma = 0.0;
+        for (size_t j = 1; j < m; ++j) sigma += x[j] * x[j];
+        if (sigma == 0.0) {
+            e[k] = alpha;
+            continue;
+        }
+        const double beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+        const double scale = 1.0 / (alpha - beta);
+        v[0] = 1.0;
+        for (size_t j = 1; j < m; ++j) v[j] = x[j] * scale;
+        const double t = (beta - alpha) / beta;
+        e[k] = beta;
+        tau[k] = t;
+
+        const unsigned threads = threadsFor(m * m, num_threads);
+        Common::parallelForChunks(0, m, ROW_CHUNK, threads, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) p[i] = t * dotProduct(a.rowPtr(k + 1 + i) + k + 1, v.data(), m);
+        });
+        const double gamma = 0.5 * t * dotProduct(p.data(), v.data(), m);
+        for (size_t i = 0; i < m; ++i) p[i] -= gamma * v[i];
+        Common::parallelForChunks(0, m, ROW_CHUNK, threads, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                double* row = a.rowPtr(k + 1 + i) + k + 1;
+                const double vi = v[i], wi = p[i];
+                for (size_t j = 0; j < m; ++j) row[j] -= vi * p[j] + wi * v[j];
+            }
+        });
+        std::copy(v.begin() + 1, v.begin() + m, x + 1);
+    }
+    if (n >= 2) {
+        d[n - 2] = a(n - 2, n - 2);
+        e[n - 2] = a(n - 1, n - 2);
+    }
+    d[n - 1] = a(n - 1, n - 1);
+}
+
+// Niejawny algorytm QL/QR z przesunięciem Wilkinsona dla macierzy trójdiagonalnej (d, e), gdzie
+// e[i] łączy d[i] i d[i+1]. Obroty Givensa są nakładane na wiersze zt (wektory własne jako wiersze),
+// więc dostęp do pamięci jest ciągły. Wynik nieposortowany.
+void tridiagonalQL(Common::ValueSeries& d, Common::ValueSeries& e, Common::DenseMatrix* zt) {
+    const size_t n = d.size();
+    const double eps = std::numeric_limits<double>::epsilon();
+    if (n > 0) e[n - 1] = 0.0;
+    // Oprócz testu względnego pomijamy e[m] na poziomie zaokrągleń całej macierzy - bez tego
+    // bloki wartości rzędu eps ||T|| (np. kowariancja niepełnego rzędu) nie zbiegają.
+    double norm = 0.0;
+    for (size_t i = 0; i < n; ++i) norm = std::max(norm, std::abs(d[i]) + std::abs(e[i]));
+    const double negligible = eps * norm;
+    for (size_t l = 0; l < n; ++l) {
+        int iteration = 0;
+        size_t m;
+        do {
+            for (m = l; m + 1 < n; ++m) {
+                const double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                if (std::abs(e[m]) <= eps * dd || std::abs(e[m]) <= negligible) break;
+            }
+            if (m == l) break;
+            if (iteration++ == QR_MAX_ITERATIONS) {
+                throw std::runtime_error("symmetricEigen: QR iteration did not converge.");
+            }
+            double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+            double r = std::hypot(g, 1.0);
+            g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+            double s = 1.0, c = 1.0, p = 0.0;
+            bool deflated = false;
+            for (size_t i = m; i-- > l;) {
+                const double f = s * e[i];
+                const double b = c * e[i];
+                r = std::hypot(f, g);
+                e[i + 1] = r;
+                if (r == 0.0) {
+                    d[i + 1] -= p;
+                    e[m] = 0.0;
+                    deflated = true;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2.0 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+                if (zt) {
+                    double* zi = zt->rowPtr(i);
+                    double* zi1 = zt->rowPtr(i + 1);
+                    const size_t cols = zt->cols();
+                    for (size_t q = 0; q < cols; ++q) {
+                        const double a0 = zi[q], a1 = zi1[q];
+                        zi1[q] = s * a0 + c * a1;
+                        zi[q] = c * a0 - s * a1;
+                    }
+                }
+            }
+            if (deflated) continue;
+            d[l] -= p;
+            e[l] = g;
+            e[m] = 0.0;
+        } while (m != l);
+    }
+}
+
+// Porządek rosnący wartości własnych.
+std::vector<size_t> ascendingOrder(const Common::ValueSeries& d) {
+    std::vector<size_t> order(d.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) { return d[i] < d[j]; });
+    return order;
+}
+
+SymmetricEigenResult solveTridiagonal(Common::ValueSeries d, Common::ValueSeries e, bool compute_vectors) {
+    const size_t n = d.size();
+    Common::DenseMatrix zt;
+    if (compute_vectors) zt = Common::DenseMatrix::identity(n);
+    tridiagonalQL(d, e, compute_vectors ? &zt : nullptr);
+
+    const std::vector<size_t> order = ascendingOrder(d);
+    SymmetricEigenResult result;
+    result.eigenvalues.resize(n);
+    for (size_t j = 0; j < n; ++j) result.eigenvalues[j] = d[order[j]];
+    if (compute_vectors) {
+        result.eigenvectors = Common::DenseMatrix(n, n);
+        for (size_t j = 0; j < n; ++j) {
+            const double* z = zt.rowPtr(order[j]);
+            for (size_t i = 0; i < n; ++i) result.eigenvectors(i, j) = z[i];
+        }
+    }
+    return result;
+}
+
+// V = H_0 H_1 ... H_{n-3} V - transformacja wektorów własnych T na wektory własne A.
+// Kolumny V są niezależne, więc dzielimy je między wątki.
+void applyReflectors(const Common::DenseMatrix& a, const Common::ValueSeries& tau, Common::DenseMatrix& V,
+                     unsigned num_threads) {
+    const size_t n = a.rows();
+    if (n < 3) return;
+    const unsigned threads = threadsFor(n * n, num_threads);
+    Common::parallelForChunks(0, n, ROW_CHUNK, threads, [&](size_t c0, size_t c1) {
+        const size_t cols = c1 - c0;
+        Common::ValueSeries w(cols);
+        for (size_t k = n - 2; k-- > 0;) {
+            if (tau[k] == 0.0) continue;
+            const double* v = a.rowPtr(k) + k + 1; // v[0] = 1 niejawnie
+            std::copy(V.rowPtr(k + 1) + c0, V.rowPtr(k + 1) + c1, w.begin());
+            for (size_t i = k + 2; i < n; ++i) axpy(v[i - k - 1], V.rowPtr(i) + c0, w.data(), cols);
+            axpy(-tau[k], w.data(), V.rowPtr(k + 1) + c0, cols);
+            for (size_t i = k + 2; i < n; ++i) axpy(-tau[k] * v[i - k - 1], w.data(), V.rowPtr(i) + c0, cols);
+        }
+    });
+}
+
+// Dwukrotna klasyczna ortogonalizacja Grama-Schmidta w względem wierszy 0..count-1 macierzy V;
+// współczynniki są dodawane do h (jeśli podane).
+void orthogonalize(const Common::DenseMatrix& V, size_t count, double* w, double* h) {
+    const size_t n = V.cols();
+    Common::ValueSeries c(count);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < count; ++i) c[i] = dotProduct(V.rowPtr(i), w, n);
+        for (size_t i = 0; i < count; ++i) {
+            axpy(-c[i], V.rowPtr(i), w, n);
+            if (h) h[i] += c[i];
+        }
+    }
+}
+
+double norm2(const double* x, size_t n) {
+    return std::sqrt(dotProduct(x, x, n));
+}
+
+// Losowy wektor jednostkowy prostopadły do pierwszych count wierszy V, zapisany w wierszu row.
+void randomOrthogonalRow(Common::DenseMatrix& V, size_t row, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const size_t n = V.cols();
+    double* x = V.rowPtr(row);
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        for (size_t i = 0; i < n; ++i) x[i] = uniform(rng);
+        orthogonalize(V, count, x, nullptr);
+        const double nrm = norm2(x, n);
+        if (nrm > 1e-8) {
+            for (size_t i = 0; i < n; ++i) x[i] /= nrm;
+            return;
+        }
+    }
+    throw std::runtime_error("lanczosTopK: Could not extend the Krylov basis.");
+}
+
+} // namespace
+
+SymmetricEigenResult tridiagonalEigen(const Common::ValueSeries& diagonal, const Common::ValueSeries& off_diagonal,
+                                      bool compute_vectors) {
+    const size_t n = diagonal.size();
+    if (n > 0 ? off_diagonal.size() != n - 1 : !off_diagonal.empty()) {
+        throw std::runtime_error("tridiagonalEigen: Off-diagonal must have n - 1 elements.");
+    }
+    Common::ValueSeries e(off_diagonal);
+    e.resize(n, 0.0);
+    return solveTridiagonal(diagonal, e, compute_vectors);
+}
+
+SymmetricEigenResult symmetricEigen(Common::ConstMatrixView A, const SymmetricEigenOptions& options) {
+    if (!A.isSquare()) {
+        throw std::runtime_error("symmetricEigen: Matrix must be square.");
+    }
+    const size_t n = A.rows();
+    Common::DenseMatrix a(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            const double value = A(i, j);
+            if (!std::isfinite(value)) {
+                throw std::runtime_error("symmetricEigen: Matrix contains non-finite values.");
+            }
+            a(i, j) = value;
+            a(j, i) = value;
+        }
+    }
+    const unsigned threads = options.num_threads == 0 ? Common::defaultThreadCount() : options.num_threads;
+
+    Common::ValueSeries d, e, tau;
+    tridiagonalize(a, d, e, tau, threads);
+    SymmetricEigenResult result = solveTridiagonal(d, e, options.compute_vectors);
+    if (options.compute_vectors) applyReflectors(a, tau, result.eigenvectors, threads);
+    return result;
+}
+
+SymmetricEigenResult symmetricEigen(const Common::Matrix& A, const SymmetricEigenOptions& options) {
+    Common::DenseMatrix dense(A);
+    return symmetricEigen(dense.view(), options);
+}
+
+LanczosResult lanczosTopK(size_t n, const SymmetricOperator& apply, size_t k, const LanczosOptions& options) {
+    if (!apply) {
+        throw std::runtime_error("lanczosTopK: Operator is empty.");
+    }
+    if (k == 0 || k > n) {
+        throw std::runtime_error("lanczosTopK: Number of eigenpairs must be in [1, n].");
+    }
+    size_t m = options.subspace_size != 0 ? options.subspace_size : std::max<size_t>(2 * k + 20, 40);
+    m = std::min(n, std::max(m, k + 2));
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    // Wiersze 0..m-1: baza ortonormalna; wiersz m: kolejny wektor (residuum po ostatnim kroku).
+    Common::DenseMatrix V(m + 1, n);
+    Common::DenseMatrix T(m, m);
+    Common::ValueSeries w(n), h(m);
+    std::mt19937 rng(options.seed);
+    randomOrthogonalRow(V, 0, 0, rng);
+
+    LanczosResult result;
+    size_t p = 0;          // liczba zachowanych wektorów Ritza
+    double beta_m = 0.0;   // norma residuum za ostatnim wektorem bazy
+    double scale = 0.0;    // oszacowanie ||A|| do progów względnych
+    for (;;) {
+        for (size_t j = p; j < m; ++j) {
+            apply(V.rowPtr(j), w.data());
+            ++result.matvecs;
+            std::fill(h.begin(), h.begin() + j + 1, 0.0);
+            orthogonalize(V, j + 1, w.data(), h.data());
+            for (size_t i = 0; i <= j; ++i) {
+                T(i, j) = h[i];
+                T(j, i) = h[i];
+            }
+            const double beta = norm2(w.data(), n);
+            scale = std::max({scale, std::abs(h[j]), beta});
+            const bool breakdown = !(beta > static_cast<double>(n) * eps * scale);
+            if (j + 1 < m) {
+                if (breakdown) {
+                    // Podprzestrzeń niezmiennicza - kontynuujemy losowym kierunkiem bez sprzężenia.
+                    randomOrthogonalRow(V, j + 1, j + 1, rng);
+                } else {
+                    double* next = V.rowPtr(j + 1);
+                    for (size_t i = 0; i < n; ++i) next[i] = w[i] / beta;
+                }
+            } else {
+                beta_m = breakdown ? 0.0 : beta;
+                double* next = V.rowPtr(m);
+                for (size_t i = 0; i < n; ++i) next[i] = breakdown ? 0.0 : w[i] / beta;
+            }
+        }
+
+        SymmetricEigenOptions small;
+        small.num_threads = 1;
+        const SymmetricEigenResult ritz = symmetricEigen(T.view(), small);
+        const double tolerance = options.tolerance * std::max(scale, std::numeric_limits<double>::min());
+        result.converged = true;
+        for (size_t i = 0; i < k; ++i) {
+            const double residual = std::abs(beta_m * ritz.eigenvectors(m - 1, m - 1 - i));
+            if (residual > tolerance) result.converged = false;
+        }
+
+        if (result.converged || result.restarts >= options.max_restarts) {
+            Common::DenseMatrix Y(m, k);
+            result.eigenvalues.resize(k);
+            result.residual_norms.resize(k);
+            for (size_t i = 0; i < k; ++i) {
+                const size_t col = m - 1 - i;
+                result.eigenvalues[i] = ritz.eigenvalues[col];
+                result.residual_norms[i] = std::abs(beta_m * ritz.eigenvectors(m - 1, col));
+                for (size_t r = 0; r < m; ++r) Y(r, i) = ritz.eigenvectors(r, col);
+            }
+            result.eigenvectors = Common::DenseMatrix(n, k);
+            gemm(Transpose::Yes, Transpose::No, 1.0, V.block(0, 0, m, n), Y.view(), 0.0, result.eigenvectors.view());
+            return result;
+        }
+
+        // Gruby restart: zostawiamy p największych wektorów Ritza i residuum jako kolejny wektor bazy.
+        ++result.restarts;
+        p = std::min(m - 1, k + (m - k) / 2);
+        Common::DenseMatrix Y(m, p);
+        for (size_t i = 0; i < p; ++i) {
+            const size_t col = m - 1 - i;
+            for (size_t r = 0; r < m; ++r) Y(r, i) = ritz.eigenvectors(r, col);
+        }
+        Common::DenseMatrix kept(p, n);
+        gemm(Transpose::Yes, Transpose::No, 1.0, Y.view(), V.block(0, 0, m, n), 0.0, kept.view());
+        for (size_t i = 0; i < p; ++i) std::copy(kept.rowPtr(i), kept.rowPtr(i) + n, V.rowPtr(i));
+        if (beta_m > 0.0) {
+            std::copy(V.rowPtr(m), V.rowPtr(m) + n, V.rowPtr(p));
+        } else {
+            randomOrthogonalRow(V, p, p, rng);
+        }
+        T.fill(0.0);
+        for (size_t i = 0; i < p; ++i) T(i, i) = ritz.eigenvalues[m - 1 - i];
+    }
+}
+
+LanczosResult lanczosTopK(Common::ConstMatrixView A, size_t k, const LanczosOptions& options) {
+    if (!A.isSquare()) {
+        throw std::runtime_error("lanczosTopK: Matrix must be square.");
+    }
+    const size_t n = A.rows();
+    const unsigned threads = threadsFor(n * n, options.num_threads == 0 ? Common::defaultThreadCount()
+                                                                        : options.num_threads);
+    SymmetricOperator apply = [&](const double* x, double* y) {
+        Common::parallelForChunks(0, n, ROW_CHUNK, threads, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) y[i] = dotProduct(A.rowPtr(i), x, n);
+        });
+    };
+    return lanczosTopK(n, apply, k, options);
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
@@ -0,0 +1,434 @@
+#include "gemm.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define METEO_GEMM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+namespace {
+
+// Rozmiary bloków pamięci podręcznej: panel B (KC x NC) mieści się w L3, panel A (MC x KC) w L2,
+// a pojedynczy fragment KC x NR panelu B w L1.
+constexpr size_t GEMM_MC = 144;
+constexpr size_t GEMM_KC = 256;
+constexpr size_t GEMM_NC = 4080;
+// Poniżej tej liczby operacji pakowanie się nie opłaca.
+constexpr size_t GEMM_SMALL_WORK = 32 * 32 * 32;
+
+constexpr size_t MAX_MR = 8;
+constexpr size_t MAX_NR = 32;
+
+template <typename T>
+using MicroKernelFn = void (*)(size_t kc, const T* a, const T* b, T* c, size_t ldc, T alpha);
+
+template <typename T>
+struct MicroKernel {
+    size_t mr;
+    size_t nr;
+    MicroKernelFn<T> fn;
+};
+
+// Mikrojądro skalarne 4x4 - kompilator i tak wektoryzuje je SSE2.
+template <typename T>
+void kernelScalar4x4(size_t kc, const T* a, const T* b, T* c, size_t ldc, T alpha) {
+    T acc[4][4] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t q = 0; q < 4; ++q) {
+                acc[r][q] += a[r] * b[q];
+            }
+        }
+        a += 4;
+        b += 4;
+    }
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t q = 0; q < 4; ++q) {
+            c[r * ldc + q] += alpha * acc[r][q];
+        }
+    }
+}
+
+#ifdef METEO_GEMM_X86
+__attribute__((target("avx2,fma")))
+void kernelAVX2_4x8(size_t kc, const double* a, const double* b, double* c, size_t ldc, double alpha) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    for (size_t p = 0; p < kc; ++p) {
+        __m256d b0 = _mm256_loadu_pd(b);
+        __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ar = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ar, b0, c00); c01 = _mm256_fmadd_pd(ar, b1, c01);
+        ar = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ar, b0, c10); c11 = _mm256_fmadd_pd(ar, b1, c11);
+        ar = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ar, b0, c20); c21 = _mm256_fmadd_pd(ar, b1, c21);
+        ar = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ar, b0, c30); c31 = _mm256_fmadd_pd(ar, b1, c31);
+        a += 4;
+        b += 8;
+    }
+    const __m256d va = _mm256_set1_pd(alpha);
+    __m256d acc[4][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    for (size_t r = 0; r < 4; ++r) {
+        double* cr = c + r * ldc;
+        _mm256_storeu_pd(cr, _mm256_fmadd_pd(va, acc[r][0], _mm256_loadu_pd(cr)));
+        _mm256_storeu_pd(cr + 4, _mm256_fmadd_pd(va, acc[r][1], _mm256_loadu_pd(cr + 4)));
+    }
+}
+
+// Wersja pojedynczej precyzji: ten sam układ rejestrów, dwa razy więcej kolumn.
+__attribute__((target("avx2,fma")))
+void kernelAVX2_4x16(size_t kc, const float* a, const float* b, float* c, size_t ldc, float alpha) {
+    __m256 acc[4][2];
+#pragma GCC unroll 4
+    for (size_t r = 0; r < 4; ++r) {
+        acc[r][0] = _mm256_setzero_ps();
+        acc[r][1] = _mm256_setzero_ps();
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 4
+        for (size_t r = 0; r < 4; ++r) {
+            __m256 ar = _mm256_broadcast_ss(a + r);
+            acc[r][0] = _mm256_fmadd_ps(ar, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(ar, b1, acc[r][1]);
+        }
+        a += 4;
+        b += 16;
+    }
+    const __m256 va = _mm256_set1_ps(alpha);
+#pragma GCC unroll 4
+    for (size_t r = 0; r < 4; ++r) {
+        float* cr = c + r * ldc;
+        _mm256_storeu_ps(cr, _mm256_fmadd_ps(va, acc[r][0], _mm256_loadu_ps(cr)));
+        _mm256_storeu_ps(cr + 8, _mm256_fmadd_ps(va, acc[r][1], _mm256_loadu_ps(cr + 8)));
+    }
+}
+
+__attribute__((target("avx512f")))
+void kernelAVX512_8x16(size_t kc, const double* a, const double* b, double* c, size_t ldc, double alpha) {
+    __m512d acc[8][2];
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        acc[r][0] = _mm512_setzero_pd();
+        acc[r][1] = _mm512_setzero_pd();
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        __m512d b0 = _mm512_loadu_pd(b);
+        __m512d b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+        for (size_t r = 0; r < 8; ++r) {
+            __m512d ar = _mm512_set1_pd(a[r]);
+            acc[r][0] = _mm512_fmadd_pd(ar, b0, acc[r][0]);
+            acc[r][1] = _mm512_fmadd_pd(ar, b1, acc[r][1]);
+        }
+        a += 8;
+        b += 16;
+    }
+    const __m512d va = _mm512_set1_pd(alpha);
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        double* cr = c + r * ldc;
+        _mm512_storeu_pd(cr, _mm512_fmadd_pd(va, acc[r][0], _mm512_loadu_pd(cr)));
+        _mm512_storeu_pd(cr + 8, _mm512_fmadd_pd(va, acc[r][1], _mm512_loadu_pd(cr + 8)));
+    }
+}
+
+__attribute__((target("avx512f")))
+void kernelAVX512_8x32(size_t kc, const float* a, const float* b, float* c, size_t ldc, float alpha) {
+    __m512 acc[8][2];
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        acc[r][0] = _mm512_setzero_ps();
+        acc[r][1] = _mm512_setzero_ps();
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        __m512 b0 = _mm512_loadu_ps(b);
+        __m512 b1 = _mm512_loadu_ps(b + 16);
+#pragma GCC unroll 8
+        for (size_t r = 0; r < 8; ++r) {
+            __m512 ar = _mm512_set1_ps(a[r]);
+            acc[r][0] = _mm512_fmadd_ps(ar, b0, acc[r][0]);
+            acc[r][1] = _mm512_fmadd_ps(ar, b1, acc[r][1]);
+        }
+        a += 8;
+        b += 32;
+    }
+    const __m512 va = _mm512_set1_ps(alpha);
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        float* cr = c + r * ldc;
+        _mm512_storeu_ps(cr, _mm512_fmadd_ps(va, acc[r][0], _mm512_loadu_ps(cr)));
+        _mm512_storeu_ps(cr + 16, _mm512_fmadd_ps(va, acc[r][1], _mm512_loadu_ps(cr + 16)));
+    }
+}
+#endif
+
+bool cpuSupports(GemmKernel kernel) {
+    switch (kernel) {
+        case GemmKernel::Auto:
+        case GemmKernel::Scalar:
+            return true;
+#ifdef METEO_GEMM_X86
+        case GemmKernel::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case GemmKernel::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#else
+        case GemmKernel::AVX2:
+        case GemmKernel::AVX512:
+            return false;
+#endif
+    }
+    return false;
+}
+
+GemmKernel resolveKernel(GemmKernel requested) {
+    if (requested != GemmKernel::Auto) return requested;
+    if (cpuSupports(GemmKernel::AVX512)) return GemmKernel::AVX512;
+    if (cpuSupports(GemmKernel::AVX2)) return GemmKernel::AVX2;
+    return GemmKernel::Scalar;
+}
+
+std::atomic<GemmKernel> g_requested_kernel{GemmKernel::Auto};
+
+template <typename T>
+MicroKernel<T> selectMicroKernel() {
+    switch (resolveKernel(g_requested_kernel.load(std::memory_order_relaxed))) {
+#ifdef METEO_GEMM_X86
+        case GemmKernel::AVX512:
+            if constexpr (std::is_same_v<T, float>) return {8, 32, kernelAVX512_8x32};
+            else return {8, 16, kernelAVX512_8x16};
+        case GemmKernel::AVX2:
+            if constexpr (std::is_same_v<T, float>) return {4, 16, kernelAVX2_4x16};
+            else return {4, 8, kernelAVX2_4x8};
+#endif
+        default:
+            return {4, 4, kernelScalar4x4<T>};
+    }
+}
+
+// Dostęp do op(X)(i, j) niezależnie od transpozycji
+template <typename T>
+inline T opAt(Common::BasicMatrixView<const T> X, bool trans, size_t i, size_t j) {
+    return trans ? X(j, i) : X(i, j);
+}
+
+template <typename T>
+void gemmSmall(bool transA, bool transB, T alpha, Common::BasicMatrixView<const T> A,
+               Common::BasicMatrixView<const T> B, Common::BasicMatrixView<T> C, size_t k) {
+    for (size_t i = 0; i < C.rows(); ++i) {
+        T* c_row = C.rowPtr(i);
+        for (size_t p = 0; p < k; ++p) {
+            const T a_ip = alpha * opAt(A, transA, i, p);
+            if (!transB) {
+                const T* b_row = B.rowPtr(p);
+                for (size_t j = 0; j < C.cols(); ++j) c_row[j] += a_ip * b_row[j];
+            } else {
+                for (size_t j = 0; j < C.cols(); ++j) c_row[j] += a_ip * B(j, p);
+            }
+        }
+    }
+}
+
+// Pakowanie bloku op(A)[i0:i0+mc, p0:p0+kc] w panele po MR wierszy (uzupełniane zerami)
+template <typename T>
+void packA(Common::BasicMatrixView<const T> A, bool transA, size_t i0, size_t mc, size_t p0, size_t kc,
+           size_t mr, T* dst) {
+    for (size_t ir = 0; ir < mc; ir += mr) {
+        size_t rows = std::min(mr, mc - ir);
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < rows; ++r) dst[r] = opAt(A, transA, i0 + ir + r, p0 + p);
+            for (size_t r = rows; r < mr; ++r) dst[r] = T(0);
+            dst += mr;
+        }
+    }
+}
+
+// Pakowanie bloku op(B)[p0:p0+kc, j0:j0+nc] w panele po NR kolumn (uzupełniane zerami)
+template <typename T>
+void packB(Common::BasicMatrixView<const T> B, bool transB, size_t p0, size_t kc, size_t j0, size_t nc,
+           size_t nr, T* dst) {
+    for (size_t jr = 0; jr < nc; jr += nr) {
+        size_t cols = std::min(nr, nc - jr);
+        for (size_t p = 0; p < kc; ++p) {
+            if (!transB) {
+                const T* src = B.rowPtr(p0 + p) + j0 + jr;
+                std::copy(src, src + cols, dst);
+            } else {
+                for (size_t q = 0; q < cols; ++q) dst[q] = B(j0 + jr + q, p0 + p);
+            }
+            std::fill(dst + cols, dst + nr, T(0));
+            dst += nr;
+        }
+    }
+}
+
+template <typename T>
+void macroKernel(const MicroKernel<T>& uk, size_t mc, size_t nc, size_t kc, T alpha,
+                 const T* Ap, const T* Bp, T* c, size_t ldc) {
+    T tile[MAX_MR * MAX_NR];
+    for (size_t jr = 0; jr < nc; jr += uk.nr) {
+        size_t cols = std::min(uk.nr, nc - jr);
+        for (size_t ir = 0; ir < mc; ir += uk.mr) {
+            size_t rows = std::min(uk.mr, mc - ir);
+            T* c_tile = c + ir * ldc + jr;
+            if (rows == uk.mr && cols == uk.nr) {
+                uk.fn(kc, Ap + ir * kc, Bp + jr * kc, c_tile, ldc, alpha);
+            } else {
+                // Brzegowy kafelek: liczymy do bufora i dodajemy tylko istniejące elementy
+                std::fill(tile, tile + uk.mr * uk.nr, T(0));
+                uk.fn(kc, Ap + ir * kc, Bp + jr * kc, tile, uk.nr, alpha);
+                for (size_t r = 0; r < rows; ++r) {
+                    for (size_t q = 0; q < cols; ++q) c_tile[r * ldc + q] += tile[r * uk.nr + q];
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void gemmImpl(Transpose transA, Transpose transB, T alpha,
+              Common::BasicMatrixView<const T> A, Common::BasicMatrixView<const T> B,
+              T beta, Common::BasicMatrixView<T> C) {
+    const bool tA = (transA == Transpose::Yes);
+    const bool tB = (transB == Transpose::Yes);
+    const size_t m = tA ? A.cols() : A.rows();
+    const size_t k = tA ? A.rows() : A.cols();
+    const size_t kB = tB ? B.cols() : B.rows();
+    const size_t n = tB ? B.rows() : B.cols();
+    if (k != kB || C.rows() != m || C.cols() != n) {
+        throw std::runtime_error("gemm: Incompatible matrix dimensions.");
+    }
+
+    if (beta != T(1)) {
+        for (size_t i = 0; i < m; ++i) {
+            T* c_row = C.rowPtr(i);
+            if (beta == T(0)) std::fill(c_row, c_row + n, T(0));
+            else for (size_t j = 0; j < n; ++j) c_row[j] *= beta;
+        }
+    }
+    if (alpha == T(0) || m == 0 || n == 0 || k == 0) return;
+
+    if (m * n * k <= GEMM_SMALL_WORK) {
+        gemmSmall(tA, tB, alpha, A, B, C, k);
+        return;
+    }
+
+    const MicroKernel<T> uk = selectMicroKernel<T>();
+    thread_local std::vector<T> A_packed;
+    thread_local std::vector<T> B_packed;
+    const size_t nc_max = std::min(GEMM_NC, (n + uk.nr - 1) / uk.nr * uk.nr);
+    const size_t mc_max = std::min(GEMM_MC, (m + uk.mr - 1) / uk.mr * uk.mr);
+    B_packed.resize(GEMM_KC * nc_max);
+    A_packed.resize(GEMM_KC * mc_max);
+
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        const size_t nc = std::min(GEMM_NC, n - jc);
+        for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+            const size_t kc = std::min(GEMM_KC, k - pc);
+            packB(B, tB, pc, kc, jc, nc, uk.nr, B_packed.data());
+            for (size_t ic = 0; ic < m; ic += GEMM_MC) {
+                const size_t mc = std::min(GEMM_MC, m - ic);
+                packA(A, tA, ic, mc, pc, kc, uk.mr, A_packed.data());
+                macroKernel(uk, mc, nc, kc, alpha, A_packed.data(), B_packed.data(),
+                            C.rowPtr(ic) + jc, C.ld());
+            }
+        }
+    }
+}
+
+template <typename T>
+void gemmParallelImpl(Transpose transA, Transpose transB, T alpha,
+                      Common::BasicMatrixView<const T> A, Common::BasicMatrixView<const T> B,
+                      T beta, Common::BasicMatrixView<T> C, unsigned num_threads) {
+    const bool tA = (transA == Transpose::Yes);
+    const bool tB = (transB == Transpose::Yes);
+    const size_t m = tA ? A.cols() : A.rows();
+    const size_t k = tA ? A.rows() : A.cols();
+    const size_t n = tB ? B.rows() : B.cols();
+    if (num_threads == 0) num_threads = Common::defaultThreadCount();
+    if (num_threads <= 1 || (tB ? B.cols() : B.rows()) != k || C.rows() != m || C.cols() != n ||
+        m * n * k <= GEMM_SMALL_WORK * num_threads) {
+        gemmImpl(transA, transB, alpha, A, B, beta, C); // także zgłasza błędne wymiary
+        return;
+    }
+
+    // Kafelki o wysokości co najmniej dwóch bloków MC; szerokość tak, by kafelków było ~2x więcej niż wątków
+    const size_t tile_m = 2 * GEMM_MC;
+    const size_t tiles_m = (m + tile_m - 1) / tile_m;
+    const size_t tiles_n_wanted = std::max<size_t>(1, (2 * num_threads + tiles_m - 1) / tiles_m);
+    const size_t tile_n = std::max<size_t>(MAX_NR, ((n + tiles_n_wanted - 1) / tiles_n_wanted + MAX_NR - 1) / MAX_NR * MAX_NR);
+    const size_t tiles_n = (n + tile_n - 1) / tile_n;
+
+    Common::parallelFor(0, tiles_m * tiles_n, num_threads, [&](size_t t) {
+        const size_t i0 = (t / tiles_n) * tile_m;
+        const size_t j0 = (t % tiles_n) * tile_n;
+        const size_t mi = std::min(tile_m, m - i0);
+        const size_t nj = std::min(tile_n, n - j0);
+        Common::BasicMatrixView<const T> A_tile = tA ? A.block(0, i0, k, mi) : A.block(i0, 0, mi, k);
+        Common::BasicMatrixView<const T> B_tile = tB ? B.block(j0, 0, nj, k) : B.block(0, j0, k, nj);
+        gemmImpl(transA, transB, alpha, A_tile, B_tile, beta, C.block(i0, j0, mi, nj));
+    });
+}
+
+} // namespace
+
+void gemm(Transpose transA, Transpose transB, double alpha,
+          Common::ConstMatrixView A, Common::ConstMatrixView B,
+          double beta, Common::MatrixView C) {
+    gemmImpl(transA, transB, alpha, A, B, beta, C);
+}
+
+void gemm(double alpha, Common::ConstMatrixView A, Common::ConstMatrixView B,
+          double beta, Common::MatrixView C) {
+    gemm(Transpose::No, Transpose::No, alpha, A, B, beta, C);
+}
+
+void gemm(Transpose transA, Transpose transB, float alpha,
+          Common::ConstFloatMatrixView A, Common::ConstFloatMatrixView B,
+          float beta, Common::FloatMatrixView C) {
+    gemmImpl(transA, transB, alpha, A, B, beta, C);
+}
+
+void gemmParallel(Transpose transA, Transpose transB, double alpha,
+                  Common::ConstMatrixView A, Common::ConstMatrixView B,
+                  double beta, Common::MatrixView C, unsigned num_threads) {
+    gemmParallelImpl(transA, transB, alpha, A, B, beta, C, num_threads);
+}
+
+void gemmParallel(Transpose transA, Transpose transB, float alpha,
+                  Common::ConstFloatMatrixView A, Common::ConstFloatMatrixView B,
+                  float beta, Common::FloatMatrixView C, unsigned num_threads) {
+    gemmParallelImpl(transA, transB, alpha, A, B, beta, C, num_threads);
+}
+
+bool isGemmKernelSupported(GemmKernel kernel) {
+    return cpuSupports(kernel);
+}
+
+void setGemmKernel(GemmKernel kernel) {
+    if (!cpuSupports(kernel)) {
+        throw std::runtime_error("setGemmKernel: Requested kernel is not supported on this CPU.");
+    }
+    g_requested_kernel.store(kernel, std::memory_order_relaxed);
+}
+
+GemmKernel activeGemmKernel() {
+    return resolveKernel(g_requested_kernel.load(std::memory_order_relaxed));
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
@@ -1,84 +1,193 @@
 #include "integration.hpp"
 #include <stdexcept>
+#include <atomic>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace MeteoNumerical {
 namespace Integration {
 
 double rectangleRule(IntegrableFunction f, double a, double b, int partitions) {
-    if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
-    double sum = 0.0;
-    double h = (b - a) / partitions;
-    for (int i = 0; i < partitions; ++i) {
-        sum += f(a + (i + 0.5) * h);
-    }
-    return sum * h;
+    return rectangleRule<const IntegrableFunction&>(f, a, b, partitions);
 }
 
 double trapezoidalRule(IntegrableFunction f, double a, double b, int partitions) {
-    if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
-    double h = (b - a) / partitions;
-    double sum = 0.5 * (f(a) + f(b));
-    for (int i = 1; i < partitions; ++i) {
-        sum += f(a + i * h);
-    }
-    return sum * h;
+    return trapezoidalRule<const IntegrableFunction&>(f, a, b, partitions);
 }
 
 double simpsonRule(IntegrableFunction f, double a, double b, int partitions) {
-    if (partitions <= 0) throw std::runtime_error("Partitions must be positive.");
-    if (partitions % 2 != 0) partitions++;
-    double h = (b - a) / partitions;
-    double sum = f(a) + f(b);
-    for (int i = 1; i < partitions; ++i) {
-        sum += (i % 2 == 0 ? 2.0 : 4.0) * f(a + i * h);
-    }
-    return sum * h / 3.0;
+    return simpsonRule<const IntegrableFunction&>(f, a, b, partitions);
 }
 
 namespace GaussLegendre {
-    static const Common::Matrix GL_NODES = {
-            {-0.5773502691708980,  0.5773502691708980},
-            {-0.7745966692414834,  0.0,                 0.7745966692414834},
-            {-0.8611363115940526, -0.3399810435848563,  0.3399810435848563,  0.8611363115940526},
-            {-0.9061798459386640, -0.5384693101056831,  0.0,                 0.5384693101056831,  0.9061798459386640},
-            {-0.9324695142031520, -0.6612093864662647, -0.2386191860831969,  0.2386191860831969,  0.6612093864662647,  0.9324695142031520}
+    // Reguły 1..SMALL_RULES-punktowe: węzły rosnąco, reguła n zaczyna się od SMALL_OFFSET[n - 1].
+    constexpr int SMALL_RULES = 10;
+    constexpr int SMALL_OFFSET[SMALL_RULES + 1] = {0, 1, 3, 6, 10, 15, 21, 28, 36, 45, 55};
+    constexpr double SMALL_NODES[55] = {
+            0.0,
+            -0.57735026918962573, 0.57735026918962573,
+            -0.7745966692414834, 0.0, 0.7745966692414834,
+            -0.86113631159405257, -0.33998104358485626, 0.33998104358485626, 0.86113631159405257,
+            -0.90617984593866396, -0.53846931010568311, 0.0, 0.53846931010568311, 0.90617984593866396,
+            -0.93246951420315205, -0.66120938646626448, -0.2386191860831969, 0.2386191860831969, 0.66120938646626448, 0.93246951420315205,
+            -0.94910791234275849, -0.74153118559939446, -0.40584515137739718, 0.0, 0.40584515137739718, 0.74153118559939446, 0.94910791234275849,
+            -0.96028985649753629, -0.79666647741362673, -0.52553240991632899, -0.18343464249564981, 0.18343464249564981, 0.52553240991632899, 0.79666647741362673, 0.96028985649753629,
+            -0.96816023950762609, -0.83603110732663577, -0.61337143270059036, -0.32425342340380892, 0.0, 0.32425342340380892, 0.61337143270059036, 0.83603110732663577, 0.96816023950762609,
+            -0.97390652851717174, -0.86506336668898454, -0.67940956829902444, -0.43339539412924721, -0.14887433898163122, 0.14887433898163122, 0.43339539412924721, 0.67940956829902444, 0.86506336668898454, 0.97390652851717174
     };
-    static const Common::Matrix GL_WEIGHTS = {
-            {1.0,                  1.0},
-            {0.5555555555555556,   0.8888888888888889,  0.5555555555555556},
-            {0.3478548451374538,   0.6521451548625461,  0.6521451548625461,  0.3478548451374538},
-            {0.2369268850561891,   0.4786286704993662,  0.5688888888888889,  0.4786286704993662,  0.2369268850561891},
-            {0.1713244923791704,   0.3607615730481386,  0.4679139345726910,  0.4679139345726910,  0.3607615730481386,  0.1713244923791704}
+    constexpr double SMALL_WEIGHTS[55] = {
+            2.0,
+            1.0, 1.0,
+            0.55555555555555558, 0.88888888888888884, 0.55555555555555558,
+            0.34785484513745385, 0.65214515486254609, 0.65214515486254609, 0.34785484513745385,
+            0.23692688505618908, 0.47862867049936647, 0.56888888888888889, 0.47862867049936647, 0.23692688505618908,
+            0.17132449237917036, 0.36076157304813861, 0.46791393457269104, 0.46791393457269104, 0.36076157304813861, 0.17132449237917036,
+            0.1294849661688697, 0.27970539148927664, 0.38183005050511892, 0.4179591836734694, 0.38183005050511892, 0.27970539148927664, 0.1294849661688697,
+            0.10122853629037626, 0.22238103445337448, 0.31370664587788727, 0.36268378337836199, 0.36268378337836199, 0.31370664587788727, 0.22238103445337448, 0.10122853629037626,
+            0.081274388361574412, 0.1806481606948574, 0.26061069640293544, 0.31234707704000286, 0.33023935500125978, 0.31234707704000286, 0.26061069640293544, 0.1806481606948574, 0.081274388361574412,
+            0.066671344308688138, 0.14945134915058059, 0.21908636251598204, 0.26926671930999635, 0.29552422471475287, 0.29552422471475287, 0.26926671930999635, 0.21908636251598204, 0.14945134915058059, 0.066671344308688138
     };
 
-    double quadrature(IntegrableFunction func, double a, double b, int num_points) {
-        if (num_points < 2 || num_points > 6) {
-            throw std::out_of_range("GaussLegendre::quadrature: num_points must be between 2 and 6.");
+    namespace {
+        struct CachedRule {
+            std::vector<double> nodes;
+            std::vector<double> weights;
+        };
+
+        // Do FAST_LIMIT punktów gotowa reguła jest odczytywana z tablicy wskaźników atomowych bez
+        // blokady; właścicielem wszystkich reguł jest mapa chroniona muteksem (reguły nie są zwalniane).
+        const int FAST_LIMIT = 1024;
+        std::atomic<const CachedRule*> fast_cache[FAST_LIMIT + 1];
+
+        std::mutex& cacheMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        std::map<int, std::unique_ptr<CachedRule>>& cacheStorage() {
+            static std::map<int, std::unique_ptr<CachedRule>> storage;
+            return storage;
+        }
+
+        // P_n(x) i P_n'(x) z rekurencji trójczłonowej
+        void legendre(int n, double x, double& p, double& dp) {
+            double p0 = 1.0, p1 = x;
+            for (int k = 2; k <= n; ++k) {
+                const double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+            }
+            p = p1;
+            dp = n * (x * p1 - p0) / (x * x - 1.0);
+        }
+
+        // Metoda Newtona dla dodatnich zer P_n (start z przybliżenia asymptotycznego); O(n^2).
+        std::unique_ptr<CachedRule> computeRule(int n) {
+            auto rule = std::make_unique<CachedRule>();
+            rule->nodes.resize(n);
+            rule->weights.resize(n);
+            const double pi = std::acos(-1.0);
+            for (int i = 0; i < (n + 1) / 2; ++i) {
+                double x = std::cos(pi * (i + 0.75) / (n + 0.5));
+                double p = 0.0, dp = 1.0;
+                for (int iter = 0; iter < 100; ++iter) {
+                    legendre(n, x, p, dp);
+                    const double dx = p / dp;
+                    x -= dx;
+                    if (std::abs(dx) <= 1e-12) break; // zbieżność kwadratowa: x jest już dokładne
+                }
+                if (2 * i + 1 == n) x = 0.0;
+                legendre(n, x, p, dp);
+                const double w = 2.0 / ((1.0 - x * x) * dp * dp);
+                rule->nodes[i] = -x;
+                rule->nodes[n - 1 - i] = x;
+                rule->weights[i] = rule->weights[n - 1 - i] = w;
+            }
+            return rule;
+        }
+    } // namespace
+
+    Rule rule(int num_points) {
+        if (num_points < 1) {
+            throw std::out_of_range("GaussLegendre::rule: num_points must be positive.");
+        }
+        if (num_points <= SMALL_RULES) {
+            const int offset = SMALL_OFFSET[num_points - 1];
+            return Rule{SMALL_NODES + offset, SMALL_WEIGHTS + offset, num_points};
         }
-        int idx = num_points - 2;
-        double sum = 0.0;
-        double transform_coeff1 = 0.5 * (b - a);
-        double transform_coeff2 = 0.5 * (a + b);
-        for (int i = 0; i < num_points; ++i) {
-            double x_transformed = transform_coeff1 * GL_NODES[idx][i] + transform_coeff2;
-            sum += GL_WEIGHTS[idx][i] * func(x_transformed);
+        const CachedRule* cached = num_points <= FAST_LIMIT
+                ? fast_cache[num_points].load(std::memory_order_acquire) : nullptr;
+        if (!cached) {
+            std::lock_guard<std::mutex> lock(cacheMutex());
+            std::unique_ptr<CachedRule>& slot = cacheStorage()[num_points];
+            if (!slot) slot = computeRule(num_points);
+            cached = slot.get();
+            if (num_points <= FAST_LIMIT) fast_cache[num_points].store(cached, std::memory_order_release);
         }
-        return sum * transform_coeff1;
+        return Rule{cached->nodes.data(), cached->weights.data(), num_points};
+    }
+
+    double quadrature(IntegrableFunction func, double a, double b, int num_points) {
+        return quadrature<const IntegrableFunction&>(func, a, b, num_points);
     }
 
     double composite(IntegrableFunction func, double a, double b, int num_points_per_interval, int num_partitions) {
-        if (num_partitions <= 0) throw std::runtime_error("Partitions must be positive.");
-        double interval_size = (b - a) / num_partitions;
-        double total_sum = 0.0;
-        for (int p = 0; p < num_partitions; ++p) {
-            double sub_a = a + p * interval_size;
-            double sub_b = sub_a + interval_size;
-            total_sum += quadrature(func, sub_a, sub_b, num_points_per_interval);
-        }
-        return total_sum;
+        return composite<const IntegrableFunction&>(func, a, b, num_points_per_interval, num_partitions);
     }
 } // namespace GaussLegendre
 
+namespace GaussKronrod {
+    // Stałe z QUADPACK (qk15, qk21)
+    static const double XGK15[8] = {
+            0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+            0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+            0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+    };
+    static const double WGK15[8] = {
+            0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+            0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+            0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+    };
+    static const double WG7[4] = {
+            0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+            0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+    };
+    static const double XGK21[11] = {
+            0.995657163025808080735527280689003, 0.973906528517171720077964012084452,
+            0.930157491355708226001207180059508, 0.865063366688984510732096688423493,
+            0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+            0.562757134668604683339000099272694, 0.433395394129247190799265943165784,
+            0.294392862701460198131126603103866, 0.148874338981631210884826001129720,
+            0.000000000000000000000000000000000
+    };
+    static const double WGK21[11] = {
+            0.011694638867371874278064396062192, 0.032558162307964727478818972459390,
+            0.054755896574351996031381300244580, 0.075039674810919952767043140916190,
+            0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+            0.123491976262065851077208067465352, 0.134709217311473325928054001771707,
+            0.142775938577060080797094273138717, 0.147739104901338491374841515972068,
+            0.149445554002916905664936468389821
+    };
+    static const double WG10[5] = {
+            0.066671344308688137593568809893332, 0.149451349150580593145776339657697,
+            0.219086362515982043995534934228163, 0.269266719309996355091226921569469,
+            0.295524224714752870173892994651338
+    };
+
+    Nodes nodes(Rule rule) {
+        if (rule == Rule::G10K21) return Nodes{XGK21, WGK21, WG10, 11, 5, false};
+        return Nodes{XGK15, WGK15, WG7, 8, 4, true};
+    }
+
+    Result integrate(IntegrableFunction f, double a, double b, const Options& options) {
+        return integrate<const IntegrableFunction&>(f, a, b, options);
+    }
+} // namespace GaussKronrod
+
 } // namespace Integration
 } // namespace MeteoNumerical
\ No newline at end of file
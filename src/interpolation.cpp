@@ -1,10 +1,102 @@
 #include "interpolation.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
 #include <stdexcept>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <string>
 
 namespace MeteoNumerical {
 namespace Interpolation {
 
+namespace {
+
+using Common::SIMD_LANES;
+using Common::LaneVec;
+
+// out[q] = p(x[q]) dla q < SIMD_LANES. Punkt trafiający dokładnie w węzeł daje NaN (inf/inf)
+// i jest poprawiany przez wywołującego - dzięki temu pętla po węzłach nie ma rozgałęzień.
+METEO_TARGET_CLONES
+void barycentricBlock(const double* nodes, const double* weights, const double* values, size_t n, size_t stride,
+                      const double* x, double* out) {
+    LaneVec xv, num = {}, den = {};
+    std::memcpy(&xv, x, sizeof(xv));
+    for (size_t j = 0; j < n; ++j) {
+        const LaneVec t = weights[j] / (xv - nodes[j * stride]);
+        num += t * values[j * stride];
+        den += t;
+    }
+    const LaneVec result = num / den;
+    std::memcpy(out, &result, sizeof(result));
+}
+
+// Zagnieżdżony Horner postaci Newtona dla pełnych bloków SIMD_LANES punktów.
+METEO_TARGET_CLONES
+void newtonBlocks(const double* nodes, const double* coeffs, size_t n, const double* x, double* out, size_t blocks) {
+    for (size_t b = 0; b < blocks; ++b) {
+        LaneVec xv;
+        std::memcpy(&xv, x + b * SIMD_LANES, sizeof(xv));
+        LaneVec r = {};
+        r += coeffs[n - 1];
+        for (size_t i = n - 1; i-- > 0;) r = r * (xv - nodes[i]) + coeffs[i];
+        std::memcpy(out + b * SIMD_LANES, &r, sizeof(r));
+    }
+}
+
+// Wagi barycentryczne w_j = 1 / prod_{k != j} (x_j - x_k) dla węzłów podanych widokiem (także co k-ty).
+void barycentricWeights(Common::ConstVectorView x, double* w, const char* where) {
+    const size_t n = x.size();
+    double lo = x[0], hi = x[0];
+    for (size_t j = 1; j < n; ++j) {
+        lo = std::min(lo, x[j]);
+        hi = std::max(hi, x[j]);
+    }
+    // Skalowanie przez pojemność przedziału (4 / (b - a)) chroni iloczyny przed nadmiarem/niedomiarem.
+    const double capacity = n > 1 ? 4.0 / (hi - lo) : 1.0;
+    for (size_t j = 0; j < n; ++j) {
+        double product = 1.0;
+        for (size_t k = 0; k < n; ++k) {
+            if (k == j) continue;
+            const double diff = x[j] - x[k];
+            if (std::abs(diff) < Common::DEFAULT_EPSILON) {
+                throw std::runtime_error(std::string(where) + ": duplicate x_nodes encountered, division by zero.");
+            }
+            product *= capacity * diff;
+        }
+        w[j] = 1.0 / product;
+    }
+}
+
+double barycentricPoint(Common::ConstVectorView nodes, const double* weights, Common::ConstVectorView values, double x) {
+    double num = 0.0, den = 0.0;
+    for (size_t j = 0; j < nodes.size(); ++j) {
+        const double diff = x - nodes[j];
+        if (diff == 0.0) return values[j];
+        const double t = weights[j] / diff;
+        num += t * values[j];
+        den += t;
+    }
+    return num / den;
+}
+
+// Wartościowanie blokami SIMD_LANES punktów; widoki węzłów i wartości mają wspólny krok.
+void barycentricEvaluate(Common::ConstVectorView nodes, const double* weights, Common::ConstVectorView values,
+                         const double* x, double* out, size_t count) {
+    double xs[SIMD_LANES], ys[SIMD_LANES];
+    for (size_t i = 0; i < count; i += SIMD_LANES) {
+        const size_t lanes = std::min(SIMD_LANES, count - i);
+        std::copy(x + i, x + i + lanes, xs);
+        std::fill(xs + lanes, xs + SIMD_LANES, xs[0]);
+        barycentricBlock(nodes.data(), weights, values.data(), nodes.size(), nodes.stride(), xs, ys);
+        for (size_t q = 0; q < lanes; ++q) {
+            out[i + q] = std::isnan(ys[q]) ? barycentricPoint(nodes, weights, values, xs[q]) : ys[q];
+        }
+    }
+}
+
+} // namespace
+
 namespace Newton {
 
 Common::Matrix calculateDividedDifferences(const Common::ValueSeries& x, const Common::ValueSeries& y) {
@@ -57,6 +149,103 @@ double newtonInterpolate(const Common::ValueSeries& x_nodes, const Common::Value
     return result;
 }
 
+void newtonInterpolateBatch(const Common::ValueSeries& x_nodes, const Common::ValueSeries& newton_coeffs,
+                       const double* xp, double* out, size_t count) {
+    if (x_nodes.empty() || newton_coeffs.empty()) {
+        throw std::runtime_error("Newton::newtonInterpolateBatch: node or coefficient vectors are empty.");
+    }
+    const size_t n = newton_coeffs.size();
+    if (n - 1 > x_nodes.size()) {
+        throw std::out_of_range("Newton::newtonInterpolateBatch: not enough x_nodes for the given coefficients.");
+    }
+    const size_t blocks = count / SIMD_LANES;
+    newtonBlocks(x_nodes.data(), newton_coeffs.data(), n, xp, out, blocks);
+    for (size_t i = blocks * SIMD_LANES; i < count; ++i) out[i] = newtonInterpolate(x_nodes, newton_coeffs, xp[i]);
+}
+
+void newtonCoefficientsInPlace(const Common::ValueSeries& x, Common::ValueSeries& values) {
+    if (x.size() != values.size() || x.empty()) {
+        throw std::runtime_error("Newton::newtonCoefficientsInPlace: x and values must have the same non-zero size.");
+    }
+    const size_t n = x.size();
+    // Po kroku j: values[i] = f[x_{i-j}, ..., x_i] dla i >= j, a values[0..j] to gotowe współczynniki.
+    for (size_t j = 1; j < n; ++j) {
+        for (size_t i = n - 1; i >= j; --i) {
+            const double dx = x[i] - x[i - j];
+            if (std::abs(dx) < Common::DEFAULT_EPSILON) {
+                throw std::runtime_error("Newton::newtonCoefficientsInPlace: duplicate x values encountered, division by zero.");
+            }
+            values[i] = (values[i] - values[i - 1]) / dx;
+        }
+    }
+}
+
+Common::ValueSeries newtonCoefficients(const Common::ValueSeries& x, const Common::ValueSeries& y) {
+    Common::ValueSeries coeffs(y);
+    newtonCoefficientsInPlace(x, coeffs);
+    return coeffs;
+}
+
+NewtonInterpolant::NewtonInterpolant(const Common::ValueSeries& x, const Common::ValueSeries& y) {
+    addNodes(x, y);
+}
+
+void NewtonInterpolant::addNode(double x, double y) {
+    const size_t n = nodes_.size();
+    for (size_t k = 0; k < n; ++k) {
+        if (std::abs(x - nodes_[k]) < Common::DEFAULT_EPSILON) {
+            throw std::runtime_error("NewtonInterpolant::addNode: duplicate x values encountered, division by zero.");
+        }
+    }
+    // Nowa przekątna od dołu: e_n = y, e_k = (e_{k+1} - f[x_k, ..., x_{n-1}]) / (x - x_k).
+    diagonal_.push_back(y);
+    for (size_t k = n; k-- > 0;) {
+        diagonal_[k] = (diagonal_[k + 1] - diagonal_[k]) / (x - nodes_[k]);
+    }
+    nodes_.push_back(x);
+    coeffs_.push_back(diagonal_[0]);
+}
+
+void NewtonInterpolant::addNodes(const Common::ValueSeries& x, const Common::ValueSeries& y) {
+    if (x.size() != y.size()) {
+        throw std::runtime_error("NewtonInterpolant::addNodes: x and y must have the same size.");
+    }
+    nodes_.reserve(nodes_.size() + x.size());
+    coeffs_.reserve(coeffs_.size() + x.size());
+    diagonal_.reserve(diagonal_.size() + x.size());
+    for (size_t i = 0; i < x.size(); ++i) addNode(x[i], y[i]);
+}
+
+void NewtonInterpolant::clear() {
+    nodes_.clear();
+    coeffs_.clear();
+    diagonal_.clear();
+}
+
+double NewtonInterpolant::evaluate(double x) const {
+    if (nodes_.empty()) {
+        throw std::runtime_error("NewtonInterpolant::evaluate: interpolant has no nodes.");
+    }
+    // Schemat Hornera dla postaci Newtona
+    size_t i = coeffs_.size() - 1;
+    double result = coeffs_[i];
+    while (i-- > 0) result = result * (x - nodes_[i]) + coeffs_[i];
+    return result;
+}
+
+void NewtonInterpolant::evaluate(const double* x, double* out, size_t count) const {
+    if (nodes_.empty()) {
+        throw std::runtime_error("NewtonInterpolant::evaluate: interpolant has no nodes.");
+    }
+    newtonInterpolateBatch(nodes_, coeffs_, x, out, count);
+}
+
+Common::ValueSeries NewtonInterpolant::evaluate(const Common::ValueSeries& x) const {
+    Common::ValueSeries out(x.size());
+    evaluate(x.data(), out.data(), x.size());
+    return out;
+}
+
 } // namespace Newton
 
 namespace Lagrange {
@@ -84,6 +273,121 @@ double lagrangeInterpolate(const Common::ValueSeries& x_nodes, const Common::Val
     return yp;
 }
 
+void lagrangeInterpolateBatch(const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes,
+                         const double* xp, double* out, size_t count) {
+    if (x_nodes.size() != y_nodes.size() || x_nodes.empty()) {
+        throw std::runtime_error("Lagrange::lagrangeInterpolateBatch: x_nodes and y_nodes must have the same non-zero size.");
+    }
+    BarycentricInterpolator(x_nodes, y_nodes).evaluate(xp, out, count);
+}
+
+Common::ValueSeries chebyshevNodes(double a, double b, size_t n, ChebyshevKind kind) {
+    if (!(a < b) || n == 0) {
+        throw std::runtime_error("Lagrange::chebyshevNodes: invalid interval or node count.");
+    }
+    Common::ValueSeries x(n);
+    const double mid = 0.5 * (a + b), half = 0.5 * (b - a);
+    if (n == 1) {
+        x[0] = mid;
+        return x;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        const double theta = kind == ChebyshevKind::FirstKind ? (2.0 * j + 1.0) * M_PI / (2.0 * n)
+                                                              : j * M_PI / (n - 1.0);
+        x[j] = mid - half * std::cos(theta);
+    }
+    if (kind == ChebyshevKind::SecondKind) {
+        x.front() = a; // dokładne końce zamiast a + O(eps)
+        x.back() = b;
+    }
+    return x;
+}
+
+BarycentricInterpolator::BarycentricInterpolator(Common::ValueSeries nodes, Common::ValueSeries weights,
+                                                 const Common::ValueSeries& y)
+        : nodes_(std::move(nodes)), weights_(std::move(weights)) {
+    setValues(y);
+}
+
+BarycentricInterpolator::BarycentricInterpolator(const Common::ValueSeries& x_nodes, const Common::ValueSeries& y_nodes) {
+    if (x_nodes.size() != y_nodes.size() || x_nodes.empty()) {
+        throw std::runtime_error("BarycentricInterpolator: x_nodes and y_nodes must have the same non-zero size.");
+    }
+    Common::ValueSeries w(x_nodes.size());
+    barycentricWeights(Common::ConstVectorView(x_nodes.data(), x_nodes.size()), w.data(), "BarycentricInterpolator");
+    nodes_ = x_nodes;
+    weights_ = std::move(w);
+    values_ = y_nodes;
+}
+
+BarycentricInterpolator BarycentricInterpolator::equispaced(double a, double b, const Common::ValueSeries& y) {
+    const size_t n = y.size();
+    if (!(a < b) || n == 0) {
+        throw std::runtime_error("BarycentricInterpolator::equispaced: invalid interval or empty values.");
+    }
+    Common::ValueSeries x(n), w(n);
+    // w_j = (-1)^j C(n-1, j), podzielone przez największy współczynnik (przez logarytmy, bez nadmiaru).
+    const double m = static_cast<double>(n - 1);
+    const double log_max = std::lgamma(m + 1.0) - std::lgamma(std::floor(m / 2) + 1.0) - std::lgamma(std::ceil(m / 2) + 1.0);
+    for (size_t j = 0; j < n; ++j) {
+        x[j] = n > 1 ? a + (b - a) * static_cast<double>(j) / m : 0.5 * (a + b);
+        const double log_c = std::lgamma(m + 1.0) - std::lgamma(j + 1.0) - std::lgamma(m - j + 1.0);
+        w[j] = (j % 2 == 0 ? 1.0 : -1.0) * std::exp(log_c - log_max);
+    }
+    if (n > 1) x.back() = b;
+    return BarycentricInterpolator(std::move(x), std::move(w), y);
+}
+
+BarycentricInterpolator BarycentricInterpolator::chebyshev(double a, double b, const Common::ValueSeries& y,
+                                                           ChebyshevKind kind) {
+    const size_t n = y.size();
+    if (!(a < b) || n == 0) {
+        throw std::runtime_error("BarycentricInterpolator::chebyshev: invalid interval or empty values.");
+    }
+    Common::ValueSeries x = chebyshevNodes(a, b, n, kind);
+    Common::ValueSeries w(n);
+    for (size_t j = 0; j < n; ++j) {
+        const double sign = j % 2 == 0 ? 1.0 : -1.0;
+        if (kind == ChebyshevKind::FirstKind) {
+            w[j] = sign * std::sin((2.0 * j + 1.0) * M_PI / (2.0 * n));
+        } else {
+            w[j] = (j == 0 || j + 1 == n) ? 0.5 * sign : sign;
+        }
+    }
+    return BarycentricInterpolator(std::move(x), std::move(w), y);
+}
+
+void BarycentricInterpolator::setValues(const Common::ValueSeries& y_nodes) {
+    if (y_nodes.size() != nodes_.size()) {
+        throw std::runtime_error("BarycentricInterpolator::setValues: value count does not match node count.");
+    }
+    values_ = y_nodes;
+}
+
+void BarycentricInterpolator::requireValid(const char* where) const {
+    if (nodes_.empty()) {
+        throw std::runtime_error(std::string(where) + ": interpolator has no nodes.");
+    }
+}
+
+double BarycentricInterpolator::evaluate(double x) const {
+    requireValid("BarycentricInterpolator::evaluate");
+    return barycentricPoint(Common::ConstVectorView(nodes_.data(), nodes_.size()), weights_.data(),
+                            Common::ConstVectorView(values_.data(), values_.size()), x);
+}
+
+void BarycentricInterpolator::evaluate(const double* x, double* out, size_t count) const {
+    requireValid("BarycentricInterpolator::evaluate");
+    barycentricEvaluate(Common::ConstVectorView(nodes_.data(), nodes_.size()), weights_.data(),
+                        Common::ConstVectorView(values_.data(), values_.size()), x, out, count);
+}
+
+Common::ValueSeries BarycentricInterpolator::evaluate(const Common::ValueSeries& x) const {
+    Common::ValueSeries out(x.size());
+    evaluate(x.data(), out.data(), x.size());
+    return out;
+}
+
 } // namespace Lagrange
 
 void selectNodesByStep(const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
@@ -108,23 +412,79 @@ double calculateInterpolationMSE(
         InterpolatorFunc interpolator,
         Common::ValueSeries* out_mse_vector,
         Common::ValueSeries* out_x_error_points) {
+    return calculateInterpolationMSE<const InterpolatorFunc&>(x_all, y_all, x_nodes, y_nodes_or_coeffs, interpolator,
+                                                              out_mse_vector, out_x_error_points);
+}
+
+double calculateInterpolationMSE(
+        const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
+        const BatchInterpolatorFunc& interpolator,
+        Common::ValueSeries* out_mse_vector,
+        Common::ValueSeries* out_x_error_points) {
     if (x_all.size() != y_all.size() || x_all.empty()) {
         throw std::runtime_error("calculateInterpolationMSE: x_all and y_all are invalid.");
     }
-    double total_mse_sum_sq_error = 0.0;
-    int count = 0;
-    if (out_mse_vector) out_mse_vector->clear();
-    if (out_x_error_points) out_x_error_points->clear();
-    for (size_t i = 0; i < x_all.size(); ++i) {
-        double y_interp = interpolator(x_nodes, y_nodes_or_coeffs, x_all[i]);
-        double error = y_interp - y_all[i];
-        double squared_error = error * error;
-        total_mse_sum_sq_error += squared_error;
-        count++;
-        if (out_mse_vector) out_mse_vector->push_back(squared_error);
-        if (out_x_error_points) out_x_error_points->push_back(x_all[i]);
-    }
-    return (count > 0) ? total_mse_sum_sq_error / count : 0.0;
+    if (!interpolator) {
+        throw std::runtime_error("calculateInterpolationMSE: interpolator is empty.");
+    }
+    const size_t n = x_all.size();
+    Common::ValueSeries squared(n);
+    interpolator(x_all.data(), squared.data(), n);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double error = squared[i] - y_all[i];
+        squared[i] = error * error;
+        sum += squared[i];
+    }
+    if (out_x_error_points) *out_x_error_points = x_all;
+    if (out_mse_vector) *out_mse_vector = std::move(squared);
+    return sum / static_cast<double>(n);
+}
+
+std::vector<NodeStepError> sweepNodeSteps(const Common::ValueSeries& x_all, const Common::ValueSeries& y_all,
+                                          unsigned k_first, unsigned k_last, const NodeStepSweepOptions& options,
+                                          const NodeViewInterpolator& interpolator) {
+    if (x_all.size() != y_all.size() || x_all.empty()) {
+        throw std::runtime_error("sweepNodeSteps: x_all and y_all are invalid.");
+    }
+    if (k_first == 0 || k_last < k_first) {
+        throw std::runtime_error("sweepNodeSteps: k range must satisfy 1 <= k_first <= k_last.");
+    }
+    const size_t total = x_all.size();
+    const size_t steps = static_cast<size_t>(k_last - k_first) + 1;
+    std::vector<NodeStepError> table(steps);
+
+    // Jeden kandydat na zadanie; kolejność rosnących k to malejący koszt, więc przydział
+    // dynamiczny kończy się drobnymi zadaniami.
+    Common::parallelForChunks(0, steps, 1, options.num_threads, [&](size_t lo, size_t hi) {
+        Common::ValueSeries weights, buffer;
+        for (size_t s = lo; s < hi; ++s) {
+            NodeStepError& entry = table[s];
+            entry.k_step = k_first + static_cast<unsigned>(s);
+            const size_t k = entry.k_step;
+            entry.node_count = (total + k - 1) / k;
+            const Common::ConstVectorView x_nodes(x_all.data(), entry.node_count, k);
+            const Common::ConstVectorView y_nodes(y_all.data(), entry.node_count, k);
+
+            Common::ValueSeries& values = options.keep_point_errors ? entry.squared_errors : buffer;
+            values.resize(total);
+            if (interpolator) {
+                interpolator(x_nodes, y_nodes, x_all.data(), values.data(), total);
+            } else {
+                weights.resize(entry.node_count);
+                barycentricWeights(x_nodes, weights.data(), "sweepNodeSteps");
+                barycentricEvaluate(x_nodes, weights.data(), y_nodes, x_all.data(), values.data(), total);
+            }
+            double sum = 0.0;
+            for (size_t i = 0; i < total; ++i) {
+                const double error = values[i] - y_all[i];
+                values[i] = error * error;
+                sum += values[i];
+            }
+            entry.mse = sum / static_cast<double>(total);
+        }
+    });
+    return table;
 }
 
 } // namespace Interpolation
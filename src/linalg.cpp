@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <string>
 
 namespace MeteoNumerical {
 namespace LinearAlgebra {
@@ -18,6 +19,16 @@ void printMatrix(const Common::Matrix& matrix, std::ostream& os, int precision)
     os << std::endl;
 }
 
+void printMatrix(Common::ConstMatrixView matrix, std::ostream& os, int precision) {
+    for (size_t i = 0; i < matrix.rows(); ++i) {
+        for (size_t j = 0; j < matrix.cols(); ++j) {
+            os << std::fixed << std::setw(10 + precision) << std::setprecision(precision) << matrix(i, j) << " ";
+        }
+        os << std::endl;
+    }
+    os << std::endl;
+}
+
 void printVector(const Common::ValueSeries& vec, std::ostream& os, int precision) {
     for (double val : vec) {
         os << std::fixed << std::setw(10 + precision) << std::setprecision(precision) << val << " ";
@@ -25,89 +36,108 @@ void printVector(const Common::ValueSeries& vec, std::ostream& os, int precision
     os << std::endl;
 }
 
-Common::ValueSeries gaussElimination(Common::Matrix A, Common::ValueSeries b) {
-    size_t n = A.size(); // Używamy size_t
-    if (n == 0 || A[0].size() != n || b.size() != n) {
+void gaussEliminationInPlace(Common::MatrixView A, Common::VectorView b, const GaussObserver& observer) {
+    const size_t n = A.rows();
+    if (n == 0 || A.cols() != n || b.size() != n) {
         throw std::runtime_error("GaussElimination: Invalid matrix or vector dimensions.");
     }
-    Common::Matrix augmented(n, Common::ValueSeries(n + 1));
-    for (size_t i = 0; i < n; ++i) { // Używamy size_t
-        for (size_t j = 0; j < n; ++j) { // Używamy size_t
-            augmented[i][j] = A[i][j];
-        }
-        augmented[i][n] = b[i];
-    }
-    
-    for (size_t k = 0; k < n; ++k) { // Używamy size_t
-        size_t max_row_idx = k; // Używamy size_t
-        for (size_t i = k + 1; i < n; ++i) { // Używamy size_t
-            if (std::abs(augmented[i][k]) > std::abs(augmented[max_row_idx][k])) {
+    for (size_t k = 0; k < n; ++k) {
+        size_t max_row_idx = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            if (std::abs(A(i, k)) > std::abs(A(max_row_idx, k))) {
                 max_row_idx = i;
             }
         }
-        std::swap(augmented[k], augmented[max_row_idx]);
-        if (std::abs(augmented[k][k]) < Common::DEFAULT_EPSILON) {
+        if (max_row_idx != k) {
+            // kolumny na lewo od k są już wyzerowane
+            std::swap_ranges(A.rowPtr(k) + k, A.rowPtr(k) + n, A.rowPtr(max_row_idx) + k);
+            std::swap(b[k], b[max_row_idx]);
+        }
+        if (std::abs(A(k, k)) < Common::DEFAULT_EPSILON) {
             throw std::runtime_error("GaussElimination: Matrix is singular.");
         }
-        for (size_t i = k + 1; i < n; ++i) { // Używamy size_t
-            double factor = augmented[i][k] / augmented[k][k];
-            for (size_t j = k; j <= n; ++j) { // Używamy size_t
-                augmented[i][j] -= factor * augmented[k][j];
+        const double* row_k = A.rowPtr(k);
+        const double inv_pivot = 1.0 / row_k[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            double* row_i = A.rowPtr(i);
+            const double factor = row_i[k] * inv_pivot;
+            row_i[k] = 0.0;
+            for (size_t j = k + 1; j < n; ++j) {
+                row_i[j] -= factor * row_k[j];
             }
+            b[i] -= factor * b[k];
+        }
+        if (observer) {
+            observer(GaussStep{k, max_row_idx, row_k[k], A, b});
         }
-       //  // Wyświetlamy macierz po każdej iteracji
-    }
-    Common::ValueSeries x;
-    x.resize(n);
-
-    if (x.size() != n) {
-        throw std::runtime_error("GaussElimination: Size mismatch in solution vector.");
     }
-    for (int i = n - 1; i >= 0; --i) { // Tutaj int jest OK, bo idziemy w dół
-        x[i] = augmented[i][n];
-        for (size_t j = i + 1; j < n; ++j) { // Używamy size_t
-            x[i] -= augmented[i][j] * x[j];
+    for (size_t i = n; i-- > 0;) {
+        const double* row_i = A.rowPtr(i);
+        double sum = b[i];
+        for (size_t j = i + 1; j < n; ++j) {
+            sum -= row_i[j] * b[j];
         }
-        x[i] /= augmented[i][i];
-        //printVector(x, std::cout, 4); // Wyświetlamy wektor rozwiązania po każdej iteracji
+        b[i] = sum / row_i[i];
+    }
+}
+
+void gaussEliminationInPlace(Common::MatrixView A, Common::ValueSeries& b, const GaussObserver& observer) {
+    gaussEliminationInPlace(A, Common::VectorView(b.data(), b.size()), observer);
+}
+
+Common::ValueSeries gaussElimination(const Common::Matrix& A, const Common::ValueSeries& b, const GaussObserver& observer) {
+    size_t n = A.size();
+    if (n == 0 || A[0].size() != n || b.size() != n) {
+        throw std::runtime_error("GaussElimination: Invalid matrix or vector dimensions.");
     }
-    std::cout << "Końcowa macierz A:\n";
-    printMatrix(augmented, std::cout, 4);
+    Common::DenseMatrix work(A);
+    Common::ValueSeries x = b;
+    gaussEliminationInPlace(work, x, observer);
     return x;
 }
 
-bool luDecompositionPivoting(const Common::Matrix& A, Common::Matrix& L, Common::Matrix& U, Common::IndexVector& P) {
-    size_t n = A.size(); // Używamy size_t
-    if (n == 0 || A[0].size() != n) return false;
-    U = A;
-    L.assign(n, Common::ValueSeries(n, 0.0));
-    P.resize(n);
-    std::iota(P.begin(), P.end(), 0);
-    for (size_t k = 0; k < n; ++k) { // Używamy size_t
-        L[k][k] = 1.0;
-        size_t maxRow_idx = k; // Używamy size_t
-        for (size_t i = k + 1; i < n; ++i) { // Używamy size_t
-            if (std::abs(U[i][k]) > std::abs(U[maxRow_idx][k])) {
-                maxRow_idx = i;
-            }
-        }
-        if (std::abs(U[maxRow_idx][k]) < Common::DEFAULT_EPSILON) {
-            return false;
-        }
-        if (maxRow_idx != k) {
-            std::swap(U[k], U[maxRow_idx]);
-            std::swap(P[k], P[maxRow_idx]);
-            for (size_t j = 0; j < k; ++j) { // Używamy size_t
-                std::swap(L[k][j], L[maxRow_idx][j]);
-            }
-        }
-        for (size_t i = k + 1; i < n; ++i) { // Używamy size_t
-            L[i][k] = U[i][k] / U[k][k];
-            for (size_t j = k; j < n; ++j) { // Używamy size_t
-                U[i][j] -= L[i][k] * U[k][j];
+Common::ValueSeries gaussElimination(Common::ConstMatrixView A, const Common::ValueSeries& b, const GaussObserver& observer) {
+    Common::DenseMatrix work(A);
+    Common::ValueSeries x = b;
+    gaussEliminationInPlace(work, x, observer);
+    return x;
+}
+
+GaussObserver printingGaussObserver(std::ostream& os, int precision) {
+    return [&os, precision](const GaussStep& step) {
+        os << std::fixed << std::setprecision(precision) << "Krok " << step.step + 1 << " (element główny " << step.pivot
+           << " z wiersza " << step.pivot_row + 1 << "):\n";
+        for (size_t i = 0; i < step.A.rows(); ++i) {
+            for (size_t j = 0; j < step.A.cols(); ++j) {
+                os << std::fixed << std::setw(10 + precision) << std::setprecision(precision) << step.A(i, j) << " ";
             }
+            os << "| " << std::setw(10 + precision) << step.b[i] << std::endl;
         }
+        os << std::endl;
+    };
+}
+
+bool luDecompositionPivoting(const Common::Matrix& A, Common::Matrix& L, Common::Matrix& U, Common::IndexVector& P,
+                             FactorizationDiagnostics* diagnostics) {
+    size_t n = A.size();
+    if (n == 0 || A[0].size() != n) return false;
+    Common::DenseMatrix L_dense, U_dense;
+    if (!luDecompositionPivoting(Common::DenseMatrix(A), L_dense, U_dense, P, diagnostics)) {
+        return false;
     }
+    L = L_dense.toNested();
+    U = U_dense.toNested();
+    return true;
+}
+
+bool luDecompositionPivoting(Common::ConstMatrixView A, Common::DenseMatrix& L, Common::DenseMatrix& U, Common::IndexVector& P,
+                             FactorizationDiagnostics* diagnostics) {
+    LUFactorization lu;
+    if (!lu.factor(A)) return false;
+    L = lu.lower();
+    U = lu.upper();
+    P = lu.permutation();
+    if (diagnostics != nullptr) *diagnostics = lu.diagnostics();
     return true;
 }
 
@@ -121,68 +151,194 @@ Common::ValueSeries permuteVector(const Common::ValueSeries& b, const Common::In
 }
 
 Common::ValueSeries forwardSubstitution(const Common::Matrix& L, const Common::ValueSeries& pb) {
-    size_t n = L.size(); // Używamy size_t
+    size_t n = L.size();
     if (n == 0 || L[0].size() != n || pb.size() != n) {
         throw std::runtime_error("forwardSubstitution: Invalid matrix/vector dimensions.");
     }
+    return forwardSubstitution(Common::DenseMatrix(L), pb);
+}
+
+Common::ValueSeries forwardSubstitution(Common::ConstMatrixView L, const Common::ValueSeries& pb) {
+    size_t n = L.rows(); // Używamy size_t
+    if (n == 0 || L.cols() != n || pb.size() != n) {
+        throw std::runtime_error("forwardSubstitution: Invalid matrix/vector dimensions.");
+    }
     Common::ValueSeries y(n);
     for (size_t i = 0; i < n; ++i) { // Używamy size_t
-        y[i] = pb[i];
+        const double* row_i = L.rowPtr(i);
+        double sum = pb[i];
         for (size_t j = 0; j < i; ++j) { // Używamy size_t
-            y[i] -= L[i][j] * y[j];
+            sum -= row_i[j] * y[j];
         }
+        y[i] = sum;
     }
     return y;
 }
 
 Common::ValueSeries backwardSubstitution(const Common::Matrix& U, const Common::ValueSeries& y) {
-    size_t n = U.size(); // Używamy size_t
+    size_t n = U.size();
     if (n == 0 || U[0].size() != n || y.size() != n) {
         throw std::runtime_error("backwardSubstitution: Invalid matrix/vector dimensions.");
     }
+    return backwardSubstitution(Common::DenseMatrix(U), y);
+}
+
+Common::ValueSeries backwardSubstitution(Common::ConstMatrixView U, const Common::ValueSeries& y) {
+    size_t n = U.rows(); // Używamy size_t
+    if (n == 0 || U.cols() != n || y.size() != n) {
+        throw std::runtime_error("backwardSubstitution: Invalid matrix/vector dimensions.");
+    }
     Common::ValueSeries x(n);
     for (int i = n - 1; i >= 0; --i) { // Tutaj int jest OK, bo idziemy w dół
-        if (std::abs(U[i][i]) < Common::DEFAULT_EPSILON) {
+        const double* row_i = U.rowPtr(i);
+        if (std::abs(row_i[i]) < Common::DEFAULT_EPSILON) {
             throw std::runtime_error("backwardSubstitution: Division by zero, singular U matrix.");
         }
-        x[i] = y[i];
+        double sum = y[i];
         for (size_t j = i + 1; j < n; ++j) { // Używamy size_t
-            x[i] -= U[i][j] * x[j];
+            sum -= row_i[j] * x[j];
         }
-        x[i] /= U[i][i];
+        x[i] = sum / row_i[i];
     }
     return x;
 }
 
+namespace {
+// Wiersze bloku przekątnego są rozwiązywane operacjami axpy na całych wierszach B
+// (wektoryzacja po prawych stronach), a reszta B aktualizowana jest przez GEMM.
+constexpr size_t TRSM_ROW_BLOCK = 64;
+constexpr size_t TRSM_COL_BLOCK = 1024;
+
+void checkTriangularSystem(Common::ConstMatrixView T, Common::MatrixView B, const char* where) {
+    if (T.rows() != T.cols() || T.rows() != B.rows()) {
+        throw std::runtime_error(std::string(where) + ": Invalid matrix dimensions.");
+    }
+}
+} // namespace
+
+void forwardSubstitutionInPlace(Common::ConstMatrixView L, Common::MatrixView B, Diagonal diag) {
+    checkTriangularSystem(L, B, "forwardSubstitutionInPlace");
+    const size_t n = L.rows();
+    for (size_t c0 = 0; c0 < B.cols(); c0 += TRSM_COL_BLOCK) {
+        const size_t m = std::min(TRSM_COL_BLOCK, B.cols() - c0);
+        Common::MatrixView X = B.block(0, c0, n, m);
+        for (size_t i0 = 0; i0 < n; i0 += TRSM_ROW_BLOCK) {
+            const size_t i1 = std::min(n, i0 + TRSM_ROW_BLOCK);
+            for (size_t i = i0; i < i1; ++i) {
+                double* x_i = X.rowPtr(i);
+                const double* l_row = L.rowPtr(i);
+                for (size_t j = i0; j < i; ++j) {
+                    const double l_ij = l_row[j];
+                    const double* x_j = X.rowPtr(j);
+                    for (size_t c = 0; c < m; ++c) x_i[c] -= l_ij * x_j[c];
+                }
+                if (diag == Diagonal::NonUnit) {
+                    if (std::abs(l_row[i]) < Common::DEFAULT_EPSILON) {
+                        throw std::runtime_error("forwardSubstitutionInPlace: Division by zero, singular L matrix.");
+                    }
+                    const double inv = 1.0 / l_row[i];
+                    for (size_t c = 0; c < m; ++c) x_i[c] *= inv;
+                }
+            }
+            if (i1 < n) {
+                gemm(-1.0, L.block(i1, i0, n - i1, i1 - i0), X.block(i0, 0, i1 - i0, m),
+                     1.0, X.block(i1, 0, n - i1, m));
+            }
+        }
+    }
+}
+
+void backwardSubstitutionInPlace(Common::ConstMatrixView U, Common::MatrixView B, Diagonal diag) {
+    checkTriangularSystem(U, B, "backwardSubstitutionInPlace");
+    const size_t n = U.rows();
+    for (size_t c0 = 0; c0 < B.cols(); c0 += TRSM_COL_BLOCK) {
+        const size_t m = std::min(TRSM_COL_BLOCK, B.cols() - c0);
+        Common::MatrixView X = B.block(0, c0, n, m);
+        for (size_t i1 = n; i1 > 0;) {
+            const size_t i0 = i1 > TRSM_ROW_BLOCK ? i1 - TRSM_ROW_BLOCK : 0;
+            for (size_t i = i1; i-- > i0;) {
+                double* x_i = X.rowPtr(i);
+                const double* u_row = U.rowPtr(i);
+                for (size_t j = i + 1; j < i1; ++j) {
+                    const double u_ij = u_row[j];
+                    const double* x_j = X.rowPtr(j);
+                    for (size_t c = 0; c < m; ++c) x_i[c] -= u_ij * x_j[c];
+                }
+                if (diag == Diagonal::NonUnit) {
+                    if (std::abs(u_row[i]) < Common::DEFAULT_EPSILON) {
+                        throw std::runtime_error("backwardSubstitutionInPlace: Division by zero, singular U matrix.");
+                    }
+                    const double inv = 1.0 / u_row[i];
+                    for (size_t c = 0; c < m; ++c) x_i[c] *= inv;
+                }
+            }
+            if (i0 > 0) {
+                gemm(-1.0, U.block(0, i0, i0, i1 - i0), X.block(i0, 0, i1 - i0, m),
+                     1.0, X.block(0, 0, i0, m));
+            }
+            i1 = i0;
+        }
+    }
+}
+
 Common::ValueSeries solveWithLU(const Common::Matrix& A, const Common::ValueSeries& b) {
-    Common::Matrix L, U;
-    Common::IndexVector P;
-    if (!luDecompositionPivoting(A, L, U, P)) {
+    size_t n = A.size();
+    if (n == 0 || A[0].size() != n) {
         throw std::runtime_error("solveWithLU: LU decomposition failed (likely singular matrix).");
     }
-    Common::ValueSeries pb = permuteVector(b, P);
-    Common::ValueSeries y = forwardSubstitution(L, pb);
-    Common::ValueSeries x = backwardSubstitution(U, y);
-    return x;
+    return solveWithLU(Common::DenseMatrix(A), b);
+}
+
+Common::ValueSeries solveWithLU(Common::ConstMatrixView A, const Common::ValueSeries& b) {
+    LUFactorization lu;
+    if (!lu.factor(A)) {
+        throw std::runtime_error("solveWithLU: LU decomposition failed (likely singular matrix).");
+    }
+    return lu.solve(b);
+}
+
+Common::DenseMatrix solveWithLU(Common::ConstMatrixView A, Common::ConstMatrixView B) {
+    LUFactorization lu;
+    if (!lu.factor(A)) {
+        throw std::runtime_error("solveWithLU: LU decomposition failed (likely singular matrix).");
+    }
+    return lu.solve(B);
+}
+
+Common::ValueSeries solve(const Common::Matrix& A, const Common::ValueSeries& b, MatrixStructure structure) {
+    size_t n = A.size();
+    if (n == 0 || A[0].size() != n) {
+        throw std::runtime_error("solve: Invalid matrix dimensions.");
+    }
+    return solve(Common::DenseMatrix(A), b, structure);
+}
+
+Common::ValueSeries solve(Common::ConstMatrixView A, const Common::ValueSeries& b, MatrixStructure structure) {
+    if (structure == MatrixStructure::SymmetricPositiveDefinite) {
+        LDLTFactorization ldlt;
+        if (!ldlt.factor(A)) {
+            throw std::runtime_error("solve: LDL^T decomposition failed (matrix not positive definite).");
+        }
+        return ldlt.solve(b);
+    }
+    return solveWithLU(A, b);
 }
 
 Common::Matrix multiplyMatrices(const Common::Matrix& A, const Common::Matrix& B) {
     if (A.empty() || B.empty() || A[0].size() != B.size()) {
         throw std::runtime_error("multiplyMatrices: Incompatible matrix dimensions for multiplication.");
     }
-    size_t rowsA = A.size();
-    size_t colsA = A[0].size();
-    size_t colsB = B[0].size();
-    Common::Matrix result(rowsA, Common::ValueSeries(colsB, 0.0));
-    for (size_t i = 0; i < rowsA; ++i) {
-        for (size_t j = 0; j < colsB; ++j) {
-            for (size_t k = 0; k < colsA; ++k) {
-                result[i][j] += A[i][k] * B[k][j];
-            }
-        }
+    return multiplyMatrices(Common::DenseMatrix(A), Common::DenseMatrix(B)).toNested();
+}
+
+Common::DenseMatrix multiplyMatrices(Common::ConstMatrixView A, Common::ConstMatrixView B) {
+    if (A.empty() || B.empty() || A.cols() != B.rows()) {
+        throw std::runtime_error("multiplyMatrices: Incompatible matrix dimensions for multiplication.");
     }
+    Common::DenseMatrix result(A.rows(), B.cols(), 0.0);
+    gemm(1.0, A, B, 0.0, result);
     return result;
 }
 
 } // namespace LinearAlgebra
-} // namespace MeteoNumerical
\ No newline at end of file
+} // namespace MeteoNumerical
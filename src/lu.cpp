@@ -0,0 +1,410 @@
+#include "lu.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <limits>
+#include <vector>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+LUFactorization::LUFactorization(Common::ConstMatrixView A, const LUOptions& options) {
+    if (!factor(A, options)) {
+        throw std::runtime_error("LUFactorization: Matrix is singular or not square.");
+    }
+}
+
+LUFactorization::LUFactorization(Common::DenseMatrix&& A, const LUOptions& options) {
+    if (!factor(std::move(A), options)) {
+        throw std::runtime_error("LUFactorization: Matrix is singular or not square.");
+    }
+}
+
+LUFactorization::LUFactorization(const Common::Matrix& A, const LUOptions& options)
+        : LUFactorization(Common::DenseMatrix(A), options) {}
+
+bool LUFactorization::factor(Common::ConstMatrixView A, const LUOptions& options) {
+    return factor(Common::DenseMatrix(A), options);
+}
+
+namespace {
+
+// Poniżej tej szerokości panel jest rozkładany bez dalszego podziału.
+constexpr size_t LU_PANEL_LEAF = 4;
+
+// B = L^{-1} B dla L trójkątnej dolnej z jedynkami na przekątnej (blok U12 = L11^{-1} A12).
+// Podział rekurencyjny sprowadza większość pracy do GEMM w precyzji T.
+template <typename T>
+void solveUnitLowerPanel(Common::BasicMatrixView<const T> L, Common::BasicMatrixView<T> B) {
+    const size_t m = L.rows();
+    if (m <= LU_PANEL_LEAF) {
+        for (size_t i = 1; i < m; ++i) {
+            T* b_i = B.rowPtr(i);
+            for (size_t k = 0; k < i; ++k) {
+                const T l_ik = L(i, k);
+                const T* b_k = B.rowPtr(k);
+                for (size_t j = 0; j < B.cols(); ++j) b_i[j] -= l_ik * b_k[j];
+            }
+        }
+        return;
+    }
+    const size_t h = m / 2;
+    solveUnitLowerPanel(L.block(0, 0, h, h), B.block(0, 0, h, B.cols()));
+    gemm(Transpose::No, Transpose::No, T(-1), L.block(h, 0, m - h, h), B.block(0, 0, h, B.cols()),
+         T(1), B.block(h, 0, m - h, B.cols()));
+    solveUnitLowerPanel(L.block(h, h, m - h, m - h), B.block(h, 0, m - h, B.cols()));
+}
+
+// Nieblokowy rozkład kolumn [j0, j0+jb) od wiersza j0 w dół; zamiany obejmują całe wiersze.
+template <typename T>
+bool factorPanelUnblocked(Common::BasicMatrixView<T> A, Common::IndexVector& pivots, size_t j0, size_t jb) {
+    const size_t n = A.rows();
+    const size_t j1 = j0 + jb;
+    for (size_t k = j0; k < j1; ++k) {
+        size_t pivot_row = k;
+        T pivot_abs = std::abs(A(k, k));
+        for (size_t i = k + 1; i < n; ++i) {
+            T v = std::abs(A(i, k));
+            if (v > pivot_abs) {
+                pivot_abs = v;
+                pivot_row = i;
+            }
+        }
+        if (!(pivot_abs >= T(Common::DEFAULT_EPSILON)) || !std::isfinite(pivot_abs)) {
+            return false;
+        }
+        pivots[k] = static_cast<int>(pivot_row);
+        if (pivot_row != k) std::swap_ranges(A.rowPtr(k), A.rowPtr(k) + n, A.rowPtr(pivot_row));
+
+        const T* row_k = A.rowPtr(k);
+        const T inv_pivot = T(1) / row_k[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            T* row_i = A.rowPtr(i);
+            const T l_ik = row_i[k] * inv_pivot;
+            row_i[k] = l_ik;
+            for (size_t j = k + 1; j < j1; ++j) {
+                row_i[j] -= l_ik * row_k[j];
+            }
+        }
+    }
+    return true;
+}
+
+// Rekurencyjny rozkład panelu: lewa połowa, U12 i aktualizacja prawej połowy przez GEMM, prawa połowa.
+// Dzięki temu większość pracy w panelu także odbywa się w GEMM zamiast w pętlach po kolumnach.
+template <typename T>
+bool factorPanel(Common::BasicMatrixView<T> A, Common::IndexVector& pivots, size_t j0, size_t jb) {
+    if (jb <= LU_PANEL_LEAF) return factorPanelUnblocked(A, pivots, j0, jb);
+    const size_t n = A.rows();
+    const size_t h = jb / 2;
+    if (!factorPanel(A, pivots, j0, h)) return false;
+    solveUnitLowerPanel<T>(A.block(j0, j0, h, h), A.block(j0, j0 + h, h, jb - h));
+    gemm(Transpose::No, Transpose::No, T(-1),
+         A.block(j0 + h, j0, n - j0 - h, h), A.block(j0, j0 + h, h, jb - h),
+         T(1), A.block(j0 + h, j0 + h, n - j0 - h, jb - h));
+    return factorPanel(A, pivots, j0 + h, jb - h);
+}
+
+// Rozkład blokowy "right-looking": panel kolumn [j0, j0+nb) jest rozkładany nieblokowo,
+// następnie liczony jest blok U12 = L11^{-1} A12, a dopełnienie Schura A22 -= L21 * U12
+// aktualizowane jest wielowątkowym, blokowym GEMM (w precyzji T).
+template <typename T>
+bool factorBlocked(Common::BasicMatrixView<T> A, Common::IndexVector& pivots, const LUOptions& options) {
+    const size_t n = A.rows();
+    if (n == 0 || A.cols() != n) return false;
+    pivots.resize(n);
+    const size_t nb = std::max<size_t>(1, options.block_size);
+
+    for (size_t j0 = 0; j0 < n; j0 += nb) {
+        const size_t jb = std::min(nb, n - j0);
+        if (!factorPanel(A, pivots, j0, jb)) return false;
+
+        const size_t j1 = j0 + jb;
+        if (j1 == n) break;
+        const size_t rest = n - j1;
+
+        solveUnitLowerPanel<T>(A.block(j0, j0, jb, jb), A.block(j0, j1, jb, rest));
+        gemmParallel(Transpose::No, Transpose::No, T(-1),
+                     A.block(j1, j0, rest, jb), A.block(j0, j1, jb, rest),
+                     T(1), A.block(j1, j1, rest, rest), options.num_threads);
+    }
+    return true;
+}
+
+// Iloczyn skalarny z ośmioma niezależnymi sumami częściowymi - bez -ffast-math kompilator
+// nie zmieni kolejności dodawań sam, a tak pętla wektoryzuje się i nie czeka na opóźnienie FMA.
+template <typename T>
+inline T dotProduct(const T* a, const T* b, size_t n) {
+    T acc[8] = {};
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        for (size_t q = 0; q < 8; ++q) acc[q] += a[j + q] * b[j + q];
+    }
+    T sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    for (; j < n; ++j) sum += a[j] * b[j];
+    return sum;
+}
+
+// Rozwiązanie A x = b na podstawie upakowanego rozkładu PA = LU (x nadpisuje b).
+template <typename T>
+void packedSolveInPlace(Common::BasicMatrixView<const T> lu, const Common::IndexVector& pivots, T* b) {
+    const size_t n = lu.rows();
+    for (size_t k = 0; k < n; ++k) std::swap(b[k], b[pivots[k]]);
+    for (size_t i = 1; i < n; ++i) {
+        b[i] -= dotProduct(lu.rowPtr(i), b, i);
+    }
+    for (size_t i = n; i-- > 0;) {
+        const T* row_i = lu.rowPtr(i);
+        b[i] = (b[i] - dotProduct(row_i + i + 1, b + i + 1, n - i - 1)) / row_i[i];
+    }
+}
+
+// Rozwiązanie A^T x = b: U^T z = b, L^T w = z, x = P^T w.
+template <typename T>
+void packedSolveTransposedInPlace(Common::BasicMatrixView<const T> lu, const Common::IndexVector& pivots, T* b) {
+    const size_t n = lu.rows();
+    // Wersje "kolumnowe", aby czytać L i U wierszami
+    for (size_t i = 0; i < n; ++i) {
+        const T* row_i = lu.rowPtr(i);
+        b[i] /= row_i[i];
+        const T z = b[i];
+        for (size_t j = i + 1; j < n; ++j) b[j] -= row_i[j] * z;
+    }
+    for (size_t i = n; i-- > 1;) {
+        const T* row_i = lu.rowPtr(i);
+        const T w = b[i];
+        for (size_t j = 0; j < i; ++j) b[j] -= row_i[j] * w;
+    }
+    for (size_t k = n; k-- > 0;) std::swap(b[k], b[pivots[k]]);
+}
+
+double normInf(const Common::ValueSeries& v) {
+    double norm = 0.0;
+    for (double x : v) norm = std::max(norm, std::abs(x));
+    return norm;
+}
+
+} // namespace
+
+bool LUFactorization::factor(Common::DenseMatrix&& A, const LUOptions& options) {
+    lu_ = std::move(A);
+    norm1_ = matrixNorm1(lu_);
+    max_abs_ = 0.0;
+    for (size_t i = 0; i < lu_.rows(); ++i) {
+        for (size_t j = 0; j < lu_.cols(); ++j) max_abs_ = std::max(max_abs_, std::abs(lu_(i, j)));
+    }
+    factored_ = factorBlocked<double>(lu_, pivots_, options);
+    return factored_;
+}
+
+void LUFactorization::requireFactored(const char* where) const {
+    if (!factored_) {
+        throw std::runtime_error(std::string(where) + ": no valid factorization available.");
+    }
+}
+
+Common::IndexVector LUFactorization::permutation() const {
+    requireFactored("LUFactorization::permutation");
+    Common::IndexVector P(size());
+    std::iota(P.begin(), P.end(), 0);
+    for (size_t k = 0; k < P.size(); ++k) {
+        std::swap(P[k], P[pivots_[k]]);
+    }
+    return P;
+}
+
+Common::DenseMatrix LUFactorization::lower() const {
+    requireFactored("LUFactorization::lower");
+    const size_t n = size();
+    Common::DenseMatrix L(n, n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(lu_.rowPtr(i), lu_.rowPtr(i) + i, L.rowPtr(i));
+        L(i, i) = 1.0;
+    }
+    return L;
+}
+
+Common::DenseMatrix LUFactorization::upper() const {
+    requireFactored("LUFactorization::upper");
+    const size_t n = size();
+    Common::DenseMatrix U(n, n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(lu_.rowPtr(i) + i, lu_.rowPtr(i) + n, U.rowPtr(i) + i);
+    }
+    return U;
+}
+
+Common::ValueSeries LUFactorization::solve(const Common::ValueSeries& b) const {
+    Common::ValueSeries x = b;
+    solveInPlace(x);
+    return x;
+}
+
+void LUFactorization::solveInPlace(Common::ValueSeries& b) const {
+    requireFactored("LUFactorization::solveInPlace");
+    if (b.size() != size()) {
+        throw std::runtime_error("LUFactorization::solveInPlace: right-hand side size mismatch.");
+    }
+    packedSolveInPlace<double>(lu_, pivots_, b.data());
+}
+
+Common::DenseMatrix LUFactorization::solve(Common::ConstMatrixView B) const {
+    Common::DenseMatrix X(B);
+    solveInPlace(X.view());
+    return X;
+}
+
+void LUFactorization::solveInPlace(Common::MatrixView B) const {
+    requireFactored("LUFactorization::solveInPlace");
+    const size_t n = size();
+    if (B.rows() != n) {
+        throw std::runtime_error("LUFactorization::solveInPlace: right-hand side size mismatch.");
+    }
+    for (size_t k = 0; k < n; ++k) {
+        const size_t p = static_cast<size_t>(pivots_[k]);
+        if (p != k) std::swap_ranges(B.rowPtr(k), B.rowPtr(k) + B.cols(), B.rowPtr(p));
+    }
+    forwardSubstitutionInPlace(lu_, B, Diagonal::Unit);
+    backwardSubstitutionInPlace(lu_, B, Diagonal::NonUnit);
+}
+
+void LUFactorization::solveTransposedInPlace(Common::ValueSeries& b) const {
+    requireFactored("LUFactorization::solveTransposedInPlace");
+    if (b.size() != size()) {
+        throw std::runtime_error("LUFactorization::solveTransposedInPlace: right-hand side size mismatch.");
+    }
+    packedSolveTransposedInPlace<double>(lu_, pivots_, b.data());
+}
+
+FactorizationDiagnostics LUFactorization::diagnostics() const {
+    requireFactored("LUFactorization::diagnostics");
+    const size_t n = size();
+    FactorizationDiagnostics result;
+    result.norm1 = norm1_;
+    setConditionEstimate(result, estimateInverseNorm1(n,
+            [&](Common::ValueSeries& x) { packedSolveInPlace<double>(lu_, pivots_, x.data()); },
+            [&](Common::ValueSeries& x) { packedSolveTransposedInPlace<double>(lu_, pivots_, x.data()); }));
+    double max_u = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j) max_u = std::max(max_u, std::abs(lu_(i, j)));
+    }
+    result.pivot_growth = max_abs_ > 0.0 ? max_u / max_abs_ : 0.0;
+    return result;
+}
+
+double LUFactorization::determinant() const {
+    requireFactored("LUFactorization::determinant");
+    double det = 1.0;
+    for (size_t k = 0; k < size(); ++k) {
+        det *= lu_(k, k);
+        if (pivots_[k] != static_cast<int>(k)) det = -det;
+    }
+    return det;
+}
+
+MixedPrecisionResult solveWithLU(Common::ConstMatrixView A, const Common::ValueSeries& b,
+                                 const MixedPrecisionOptions& options) {
+    const size_t n = A.rows();
+    if (n == 0 || A.cols() != n || b.size() != n) {
+        throw std::runtime_error("solveWithLU: Invalid matrix or vector dimensions.");
+    }
+    const unsigned threads = options.lu.num_threads;
+    const double norm_A1 = matrixNorm1(A);
+    double norm_Ainf = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double row_sum = 0.0;
+        for (size_t j = 0; j < n; ++j) row_sum += std::abs(A(i, j));
+        norm_Ainf = std::max(norm_Ainf, row_sum);
+    }
+    const double tolerance = options.tolerance > 0.0
+            ? options.tolerance
+            : std::sqrt(static_cast<double>(n)) * std::numeric_limits<double>::epsilon();
+
+    MixedPrecisionResult result;
+    Common::ValueSeries r(n);
+    // r = b - A x w podwójnej precyzji; zwraca ||r||_inf
+    auto residual = [&](const Common::ValueSeries& x) {
+        Common::parallelForChunks(0, n, 64, threads, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                r[i] = b[i] - dotProduct(A.rowPtr(i), x.data(), n);
+            }
+        });
+        return normInf(r);
+    };
+    auto backwardError = [&](double r_norm, const Common::ValueSeries& x) {
+        const double denom = norm_Ainf * normInf(x);
+        return denom > 0.0 ? r_norm / denom : r_norm;
+    };
+
+    // Kopia A w pojedynczej precyzji; wartości spoza zakresu float wymuszają tryb double.
+    std::vector<float> lu_f(n * n);
+    bool fits_float = true;
+    for (size_t i = 0; i < n && fits_float; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const double v = A(i, j);
+            if (std::abs(v) > static_cast<double>(std::numeric_limits<float>::max())) {
+                fits_float = false;
+                break;
+            }
+            lu_f[i * n + j] = static_cast<float>(v);
+        }
+    }
+    Common::IndexVector pivots_f;
+    const Common::FloatMatrixView LUf(lu_f.data(), n, n);
+    const bool factored_f = fits_float && factorBlocked<float>(LUf, pivots_f, options.lu);
+
+    if (factored_f) {
+        std::vector<float> work(n);
+        // Rozwiązanie w float dla prawej strony w double
+        auto solveFloat = [&](const Common::ValueSeries& rhs, Common::ValueSeries& out, bool transposed) {
+            for (size_t i = 0; i < n; ++i) work[i] = static_cast<float>(rhs[i]);
+            if (transposed) packedSolveTransposedInPlace<float>(LUf, pivots_f, work.data());
+            else packedSolveInPlace<float>(LUf, pivots_f, work.data());
+            for (size_t i = 0; i < n; ++i) out[i] = static_cast<double>(work[i]);
+        };
+        result.condition_estimate = norm_A1 * estimateInverseNorm1(n,
+                [&](Common::ValueSeries& x) { solveFloat(x, x, false); },
+                [&](Common::ValueSeries& x) { solveFloat(x, x, true); });
+
+        Common::ValueSeries x(n), d(n);
+        solveFloat(b, x, false);
+        double r_norm = residual(x);
+        double prev_r_norm = std::numeric_limits<double>::infinity();
+        for (size_t step = 0; ; ++step) {
+            if (!std::isfinite(r_norm)) break;
+            if (r_norm <= tolerance * norm_Ainf * normInf(x)) {
+                result.x = std::move(x);
+                result.refinement_steps = step;
+                result.backward_error = backwardError(r_norm, result.x);
+                return result;
+            }
+            // Brak co najmniej dwukrotnego spadku residuum oznacza, że poprawianie nie zbiegnie
+            // (kappa(A) * eps_float >~ 1) - od razu przechodzimy do rozkładu w double.
+            if (step >= options.max_refinement_steps || r_norm > 0.5 * prev_r_norm) break;
+            solveFloat(r, d, false);
+            for (size_t i = 0; i < n; ++i) x[i] += d[i];
+            prev_r_norm = r_norm;
+            r_norm = residual(x);
+            result.refinement_steps = step + 1;
+        }
+    }
+
+    LUFactorization lu;
+    if (!lu.factor(A, options.lu)) {
+        throw std::runtime_error("solveWithLU: Matrix is singular.");
+    }
+    result.used_double_fallback = true;
+    result.x = lu.solve(b);
+    result.backward_error = backwardError(residual(result.x), result.x);
+    if (!factored_f) {
+        result.condition_estimate = lu.diagnostics().condition_estimate;
+    }
+    return result;
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
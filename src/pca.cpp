@@ -0,0 +1,179 @@
+#include "pca.hpp"
+#include "eigen.hpp"
+#include "gemm.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+namespace MeteoNumerical {
+namespace Statistics {
+
+namespace {
+
+// Od tylu kolumn i przy co najwyżej 1/10 składowych Lanczos wyprzedza pełny rozkład.
+const size_t LANCZOS_MIN_COLUMNS = 200;
+
+double fieldValue(const DataStructures::Measurement& m, MeasurementField field) {
+    switch (field) {
+        case MeasurementField::Temperature: return m.temperature_celsius;
+        case MeasurementField::Humidity: return m.humidity_percent;
+        case MeasurementField::Pressure: return m.pressure_hpa;
+        case MeasurementField::WindSpeed: return m.wind_speed_mps;
+    }
+    return NAN;
+}
+
+} // namespace
+
+Common::DenseMatrix measurementMatrix(const DataStructures::MeasurementSeries& series,
+                                      const std::vector<MeasurementField>& fields) {
+    return measurementMatrix(std::vector<DataStructures::MeasurementSeries>{series}, fields);
+}
+
+Common::DenseMatrix measurementMatrix(const std::vector<DataStructures::MeasurementSeries>& stations,
+                                      const std::vector<MeasurementField>& fields) {
+    if (stations.empty() || fields.empty()) {
+        throw std::runtime_error("measurementMatrix: No stations or fields selected.");
+    }
+    const size_t samples = stations[0].size();
+    for (const auto& s : stations) {
+        if (s.size() != samples) {
+            throw std::runtime_error("measurementMatrix: Station series have different lengths.");
+        }
+    }
+    const size_t cols = stations.size() * fields.size();
+    Common::DenseMatrix data(samples, cols);
+    size_t rows = 0;
+    for (size_t t = 0; t < samples; ++t) {
+        double* row = data.rowPtr(rows);
+        bool complete = true;
+        for (size_t s = 0; s < stations.size() && complete; ++s) {
+            for (size_t f = 0; f < fields.size(); ++f) {
+                const double value = fieldValue(stations[s][t], fields[f]);
+                if (std::isnan(value)) {
+                    complete = false;
+                    break;
+                }
+                row[s * fields.size() + f] = value;
+            }
+        }
+        if (complete) ++rows;
+    }
+    if (rows == samples) return data;
+    return Common::DenseMatrix(data.block(0, 0, rows, cols));
+}
+
+PCAResult principalComponents(Common::ConstMatrixView data, const PCAOptions& options) {
+    const size_t samples = data.rows();
+    const size_t p = data.cols();
+    if (samples < 2 || p == 0) {
+        throw std::runtime_error("principalComponents: At least two observations of one variable are required.");
+    }
+    const size_t k = options.num_components == 0 ? p : options.num_components;
+    if (k > p) {
+        throw std::runtime_error("principalComponents: More components requested than variables.");
+    }
+
+    PCAResult result;
+    result.mean.assign(p, 0.0);
+    result.scale.assign(p, 1.0);
+    for (size_t i = 0; i < samples; ++i) {
+        const double* row = data.rowPtr(i);
+        for (size_t j = 0; j < p; ++j) result.mean[j] += row[j];
+    }
+    for (double& m : result.mean) m /= static_cast<double>(samples);
+
+    // Wycentrowane (i ewentualnie wystandaryzowane) dane; C = X^T X / (N - 1).
+    Common::DenseMatrix centered(samples, p);
+    for (size_t i = 0; i < samples; ++i) {
+        const double* src = data.rowPtr(i);
+        double* dst = centered.rowPtr(i);
+        for (size_t j = 0; j < p; ++j) dst[j] = src[j] - result.mean[j];
+    }
+    if (options.standardize) {
+        Common::ValueSeries sum_sq(p, 0.0);
+        for (size_t i = 0; i < samples; ++i) {
+            const double* row = centered.rowPtr(i);
+            for (size_t j = 0; j < p; ++j) sum_sq[j] += row[j] * row[j];
+        }
+        for (size_t j = 0; j < p; ++j) {
+            const double sd = std::sqrt(sum_sq[j] / static_cast<double>(samples - 1));
+            result.scale[j] = sd > 0.0 ? sd : 1.0; // stała kolumna nie wnosi wariancji
+        }
+        for (size_t i = 0; i < samples; ++i) {
+            double* row = centered.rowPtr(i);
+            for (size_t j = 0; j < p; ++j) row[j] /= result.scale[j];
+        }
+    }
+    Common::DenseMatrix covariance(p, p);
+    LinearAlgebra::gemmParallel(LinearAlgebra::Transpose::Yes, LinearAlgebra::Transpose::No,
+                                1.0 / static_cast<double>(samples - 1), centered.view(), centered.view(),
+                                0.0, covariance.view(), options.num_threads);
+    for (size_t j = 0; j < p; ++j) result.total_variance += covariance(j, j);
+
+    result.components = Common::DenseMatrix(p, k);
+    result.variances.resize(k);
+    bool solved = false;
+    if (p >= LANCZOS_MIN_COLUMNS && 10 * k <= p) {
+        LinearAlgebra::LanczosOptions lanczos;
+        lanczos.num_threads = options.num_threads;
+        lanczos.max_restarts = options.lanczos_max_restarts;
+        LinearAlgebra::LanczosResult top = LinearAlgebra::lanczosTopK(covariance.view(), k, lanczos);
+        if (top.converged) {
+            result.variances = top.eigenvalues;
+            result.components = std::move(top.eigenvectors);
+            solved = true;
+        }
+    }
+    if (!solved) {
+        LinearAlgebra::SymmetricEigenOptions eigen;
+        eigen.num_threads = options.num_threads;
+        const LinearAlgebra::SymmetricEigenResult full = LinearAlgebra::symmetricEigen(covariance.view(), eigen);
+        for (size_t c = 0; c < k; ++c) {
+            const size_t src = p - 1 - c;
+            result.variances[c] = full.eigenvalues[src];
+            for (size_t r = 0; r < p; ++r) result.components(r, c) = full.eigenvectors(r, src);
+        }
+    }
+
+    result.explained_variance_ratio.resize(k);
+    for (size_t c = 0; c < k; ++c) {
+        // Wartości bliskie zera mogą wyjść minimalnie ujemne przez zaokrąglenia.
+        result.variances[c] = std::max(result.variances[c], 0.0);
+        result.explained_variance_ratio[c] =
+            result.total_variance > 0.0 ? result.variances[c] / result.total_variance : 0.0;
+        size_t largest = 0;
+        for (size_t r = 1; r < p; ++r) {
+            if (std::abs(result.components(r, c)) > std::abs(result.components(largest, c))) largest = r;
+        }
+        if (result.components(largest, c) < 0.0) {
+            for (size_t r = 0; r < p; ++r) result.components(r, c) = -result.components(r, c);
+        }
+    }
+    return result;
+}
+
+PCAResult principalComponents(const std::vector<DataStructures::MeasurementSeries>& stations,
+                              const std::vector<MeasurementField>& fields, const PCAOptions& options) {
+    const Common::DenseMatrix data = measurementMatrix(stations, fields);
+    return principalComponents(data.view(), options);
+}
+
+Common::DenseMatrix projectOntoComponents(const PCAResult& pca, Common::ConstMatrixView data) {
+    const size_t p = pca.components.rows();
+    if (data.cols() != p) {
+        throw std::runtime_error("projectOntoComponents: Column count does not match the PCA model.");
+    }
+    Common::DenseMatrix centered(data.rows(), p);
+    for (size_t i = 0; i < data.rows(); ++i) {
+        const double* src = data.rowPtr(i);
+        double* dst = centered.rowPtr(i);
+        for (size_t j = 0; j < p; ++j) dst[j] = (src[j] - pca.mean[j]) / pca.scale[j];
+    }
+    Common::DenseMatrix scores(data.rows(), pca.components.cols());
+    LinearAlgebra::gemm(1.0, centered.view(), pca.components.view(), 0.0, scores.view());
+    return scores;
+}
+
+} // namespace Statistics
+} // namespace MeteoNumerical
@@ -0,0 +1,373 @@
+#include "qr.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+namespace {
+
+// Liczba wierszy dokładanych naraz do IncrementalLeastSquares (blok mieszczący się w L2).
+size_t chunkRows(size_t cols) {
+    return std::max<size_t>(256, 8 * cols);
+}
+
+// Odbicie Householdera dla kolumny k od wiersza k (jak LAPACK dlarfg): A(k,k) = beta,
+// pod przekątną v (z v_k = 1 niejawnie), zwraca tau.
+double makeReflector(Common::MatrixView A, size_t k) {
+    const size_t m = A.rows();
+    const double alpha = A(k, k);
+    double sigma = 0.0;
+    for (size_t i = k + 1; i < m; ++i) sigma += A(i, k) * A(i, k);
+    if (sigma == 0.0) return 0.0;
+    const double beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+    const double scale = 1.0 / (alpha - beta);
+    for (size_t i = k + 1; i < m; ++i) A(i, k) *= scale;
+    A(k, k) = beta;
+    return (beta - alpha) / beta;
+}
+
+// A[k:, c0:c1] = (I - tau v v^T) A[k:, c0:c1]; przechodzi wierszami, więc dostęp jest ciągły.
+void applyReflector(Common::MatrixView A, size_t k, double tau, size_t c0, size_t c1, Common::ValueSeries& w) {
+    if (tau == 0.0 || c0 >= c1) return;
+    const size_t m = A.rows();
+    const size_t cols = c1 - c0;
+    w.assign(A.rowPtr(k) + c0, A.rowPtr(k) + c1);
+    for (size_t i = k + 1; i < m; ++i) {
+        const double v_i = A(i, k);
+        const double* row = A.rowPtr(i) + c0;
+        for (size_t j = 0; j < cols; ++j) w[j] += v_i * row[j];
+    }
+    double* row_k = A.rowPtr(k) + c0;
+    for (size_t j = 0; j < cols; ++j) row_k[j] -= tau * w[j];
+    for (size_t i = k + 1; i < m; ++i) {
+        const double tv = tau * A(i, k);
+        double* row = A.rowPtr(i) + c0;
+        for (size_t j = 0; j < cols; ++j) row[j] -= tv * w[j];
+    }
+}
+
+// Jawna macierz V (m - j0) x jb bloku odbić: jedynki na przekątnej, zera nad nią.
+Common::DenseMatrix explicitV(Common::ConstMatrixView A, size_t j0, size_t jb) {
+    const size_t rows = A.rows() - j0;
+    Common::DenseMatrix V(rows, jb, 0.0);
+    for (size_t r = 0; r < rows; ++r) {
+        const double* src = A.rowPtr(j0 + r) + j0;
+        double* dst = V.rowPtr(r);
+        const size_t below = std::min(r, jb);
+        std::copy(src, src + below, dst);
+        if (r < jb) dst[r] = 1.0;
+    }
+    return V;
+}
+
+// Górnotrójkątna T taka, że H_0 H_1 ... H_{jb-1} = I - V T V^T (jak LAPACK dlarft).
+Common::DenseMatrix buildT(Common::ConstMatrixView V, const double* tau) {
+    const size_t jb = V.cols();
+    Common::DenseMatrix S(jb, jb);
+    gemm(Transpose::Yes, Transpose::No, 1.0, V, V, 0.0, S);
+    Common::DenseMatrix T(jb, jb, 0.0);
+    for (size_t i = 0; i < jb; ++i) {
+        T(i, i) = tau[i];
+        for (size_t r = 0; r < i; ++r) {
+            double sum = 0.0;
+            for (size_t c = r; c < i; ++c) sum += T(r, c) * S(c, i);
+            T(r, i) = -tau[i] * sum;
+        }
+    }
+    return T;
+}
+
+// C = (I - V op(T) V^T) C, gdzie op(T) = T^T dla Q^T oraz T dla Q.
+void applyBlock(Common::ConstMatrixView V, Common::ConstMatrixView T, Common::MatrixView C,
+                bool transposed, unsigned num_threads) {
+    if (C.cols() == 0) return;
+    Common::DenseMatrix W(V.cols(), C.cols());
+    gemmParallel(Transpose::Yes, Transpose::No, 1.0, V, C, 0.0, W, num_threads);
+    Common::DenseMatrix TW(V.cols(), C.cols());
+    gemm(transposed ? Transpose::Yes : Transpose::No, Transpose::No, 1.0, T, W, 0.0, TW);
+    gemmParallel(Transpose::No, Transpose::No, -1.0, V, TW, 1.0, C, num_threads);
+}
+
+// Blokowy rozkład Householdera w miejscu: panel jb kolumn rozkładany jest odbiciami pojedynczymi,
+// a reszta kolumn aktualizowana naraz w postaci zwartej WY (dwa GEMM zamiast jb przejść po macierzy).
+void householderQR(Common::MatrixView A, Common::ValueSeries& tau, std::vector<Common::DenseMatrix>* t_blocks,
+                   size_t block_size, unsigned num_threads) {
+    const size_t m = A.rows();
+    const size_t n = A.cols();
+    const size_t kmax = std::min(m, n);
+    const size_t nb = std::max<size_t>(1, block_size);
+    tau.assign(kmax, 0.0);
+    Common::ValueSeries w;
+    for (size_t j0 = 0; j0 < kmax; j0 += nb) {
+        const size_t jb = std::min(nb, kmax - j0);
+        const size_t j1 = j0 + jb;
+        for (size_t k = j0; k < j1; ++k) {
+            tau[k] = makeReflector(A, k);
+            applyReflector(A, k, tau[k], k + 1, j1, w);
+        }
+        if (j1 == n && t_blocks == nullptr) continue;
+        Common::DenseMatrix V = explicitV(A, j0, jb);
+        Common::DenseMatrix T = buildT(V, tau.data() + j0);
+        if (j1 < n) applyBlock(V, T, A.block(j0, j1, m - j0, n - j1), true, num_threads);
+        if (t_blocks != nullptr) t_blocks->push_back(std::move(T));
+    }
+}
+
+void requireFullRank(Common::ConstMatrixView R, const char* where) {
+    double max_diag = 0.0;
+    for (size_t k = 0; k < R.rows(); ++k) max_diag = std::max(max_diag, std::abs(R(k, k)));
+    for (size_t k = 0; k < R.rows(); ++k) {
+        if (max_diag == 0.0 || std::abs(R(k, k)) <= Common::DEFAULT_EPSILON * max_diag) {
+            throw std::runtime_error(std::string(where) + ": Matrix is rank deficient.");
+        }
+    }
+}
+
+// R = górny trójkąt rozkładu QR macierzy [R; rows]
+void foldRows(Common::DenseMatrix& R, Common::ConstMatrixView rows) {
+    const size_t p = R.rows();
+    Common::DenseMatrix S(p + rows.rows(), p);
+    for (size_t i = 0; i < p; ++i) std::copy(R.rowPtr(i), R.rowPtr(i) + p, S.rowPtr(i));
+    for (size_t i = 0; i < rows.rows(); ++i) std::copy(rows.rowPtr(i), rows.rowPtr(i) + p, S.rowPtr(p + i));
+    Common::ValueSeries tau;
+    householderQR(S, tau, nullptr, QROptions().block_size, 1);
+    for (size_t i = 0; i < p; ++i) {
+        std::fill(R.rowPtr(i), R.rowPtr(i) + i, 0.0);
+        std::copy(S.rowPtr(i) + i, S.rowPtr(i) + p, R.rowPtr(i) + i);
+    }
+}
+
+} // namespace
+
+// --- QRFactorization ---
+
+QRFactorization::QRFactorization(Common::ConstMatrixView A, const QROptions& options) {
+    if (!factor(A, options)) {
+        throw std::runtime_error("QRFactorization: Matrix is empty or has fewer rows than columns.");
+    }
+}
+
+QRFactorization::QRFactorization(const Common::Matrix& A, const QROptions& options)
+        : QRFactorization(Common::DenseMatrix(A), options) {}
+
+bool QRFactorization::factor(Common::ConstMatrixView A, const QROptions& options) {
+    factored_ = false;
+    t_blocks_.clear();
+    if (A.empty() || A.rows() < A.cols()) return false;
+    qr_ = Common::DenseMatrix(A);
+    block_size_ = std::max<size_t>(1, options.block_size);
+    num_threads_ = options.num_threads;
+    householderQR(qr_, tau_, &t_blocks_, block_size_, num_threads_);
+    factored_ = true;
+    return true;
+}
+
+void QRFactorization::requireFactored(const char* where) const {
+    if (!factored_) {
+        throw std::runtime_error(std::string(where) + ": no valid factorization available.");
+    }
+}
+
+Common::DenseMatrix QRFactorization::R() const {
+    requireFactored("QRFactorization::R");
+    const size_t n = cols();
+    Common::DenseMatrix R(n, n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(qr_.rowPtr(i) + i, qr_.rowPtr(i) + n, R.rowPtr(i) + i);
+    }
+    return R;
+}
+
+Common::DenseMatrix QRFactorization::thinQ() const {
+    requireFactored("QRFactorization::thinQ");
+    const size_t m = rows(), n = cols();
+    Common::DenseMatrix Q(m, n, 0.0);
+    for (size_t i = 0; i < n; ++i) Q(i, i) = 1.0;
+    // Q [I; 0] = H_0 ... H_{n-1} [I; 0] - bloki w odwrotnej kolejności
+    for (size_t b = t_blocks_.size(); b-- > 0;) {
+        const size_t j0 = b * block_size_;
+        const size_t jb = t_blocks_[b].rows();
+        Common::DenseMatrix V = explicitV(qr_, j0, jb);
+        applyBlock(V, t_blocks_[b], Q.block(j0, 0, m - j0, n), false, num_threads_);
+    }
+    return Q;
+}
+
+void QRFactorization::applyQTransposeInPlace(Common::ValueSeries& b) const {
+    applyQTransposeInPlace(Common::MatrixView(b.data(), b.size(), 1));
+}
+
+void QRFactorization::applyQTransposeInPlace(Common::MatrixView B) const {
+    requireFactored("QRFactorization::applyQTransposeInPlace");
+    const size_t m = rows();
+    if (B.rows() != m) {
+        throw std::runtime_error("QRFactorization::applyQTransposeInPlace: right-hand side size mismatch.");
+    }
+    for (size_t b = 0; b < t_blocks_.size(); ++b) {
+        const size_t j0 = b * block_size_;
+        const size_t jb = t_blocks_[b].rows();
+        Common::DenseMatrix V = explicitV(qr_, j0, jb);
+        applyBlock(V, t_blocks_[b], B.block(j0, 0, m - j0, B.cols()), true, num_threads_);
+    }
+}
+
+void QRFactorization::solveR(const char* where, Common::MatrixView X) const {
+    Common::ConstMatrixView R = qr_.block(0, 0, cols(), cols());
+    requireFullRank(R, where);
+    backwardSubstitutionInPlace(R, X, Diagonal::NonUnit);
+}
+
+LeastSquaresResult QRFactorization::solveLeastSquares(const Common::ValueSeries& b) const {
+    requireFactored("QRFactorization::solveLeastSquares");
+    if (b.size() != rows()) {
+        throw std::runtime_error("QRFactorization::solveLeastSquares: right-hand side size mismatch.");
+    }
+    const size_t n = cols();
+    Common::ValueSeries y = b;
+    applyQTransposeInPlace(y);
+
+    LeastSquaresResult result;
+    double sum_sq = 0.0;
+    for (size_t i = n; i < y.size(); ++i) sum_sq += y[i] * y[i];
+    result.residual_norm = std::sqrt(sum_sq);
+    result.x.assign(y.begin(), y.begin() + n);
+    solveR("QRFactorization::solveLeastSquares", Common::MatrixView(result.x.data(), n, 1));
+    return result;
+}
+
+Common::DenseMatrix QRFactorization::solveLeastSquares(Common::ConstMatrixView B) const {
+    requireFactored("QRFactorization::solveLeastSquares");
+    if (B.rows() != rows()) {
+        throw std::runtime_error("QRFactorization::solveLeastSquares: right-hand side size mismatch.");
+    }
+    Common::DenseMatrix Y(B);
+    applyQTransposeInPlace(Y.view());
+    Common::DenseMatrix X(Y.block(0, 0, cols(), Y.cols()));
+    solveR("QRFactorization::solveLeastSquares", X.view());
+    return X;
+}
+
+// --- IncrementalLeastSquares ---
+
+IncrementalLeastSquares::IncrementalLeastSquares(size_t num_predictors)
+        : n_(num_predictors), r_(num_predictors + 1, num_predictors + 1, 0.0) {
+    if (num_predictors == 0) {
+        throw std::runtime_error("IncrementalLeastSquares: Number of predictors must be positive.");
+    }
+}
+
+void IncrementalLeastSquares::addRow(const Common::ValueSeries& x, double y) {
+    if (x.size() != n_) {
+        throw std::runtime_error("IncrementalLeastSquares::addRow: Row size does not match number of predictors.");
+    }
+    if (pending_.empty()) pending_ = Common::DenseMatrix(chunkRows(n_ + 1), n_ + 1);
+    double* row = pending_.rowPtr(pending_rows_);
+    std::copy(x.begin(), x.end(), row);
+    row[n_] = y;
+    ++observations_;
+    if (++pending_rows_ == pending_.rows()) flush();
+}
+
+void IncrementalLeastSquares::addRows(Common::ConstMatrixView X, const Common::ValueSeries& y) {
+    if (X.cols() != n_ || y.size() != X.rows()) {
+        throw std::runtime_error("IncrementalLeastSquares::addRows: Incompatible dimensions.");
+    }
+    const size_t chunk = chunkRows(n_ + 1);
+    Common::DenseMatrix block(std::min(chunk, X.rows()), n_ + 1);
+    for (size_t i0 = 0; i0 < X.rows(); i0 += chunk) {
+        const size_t rows = std::min(chunk, X.rows() - i0);
+        for (size_t r = 0; r < rows; ++r) {
+            std::copy(X.rowPtr(i0 + r), X.rowPtr(i0 + r) + n_, block.rowPtr(r));
+            block(r, n_) = y[i0 + r];
+        }
+        absorb(block.block(0, 0, rows, n_ + 1));
+    }
+    observations_ += X.rows();
+}
+
+void IncrementalLeastSquares::merge(const IncrementalLeastSquares& other) {
+    if (other.n_ != n_) {
+        throw std::runtime_error("IncrementalLeastSquares::merge: Number of predictors differs.");
+    }
+    absorb(other.currentR());
+    observations_ += other.observations_;
+}
+
+void IncrementalLeastSquares::flush() {
+    if (pending_rows_ == 0) return;
+    absorb(pending_.block(0, 0, pending_rows_, n_ + 1));
+    pending_rows_ = 0;
+}
+
+void IncrementalLeastSquares::absorb(Common::ConstMatrixView rows) {
+    foldRows(r_, rows);
+}
+
+Common::DenseMatrix IncrementalLeastSquares::currentR() const {
+    Common::DenseMatrix R = r_;
+    if (pending_rows_ > 0) foldRows(R, pending_.block(0, 0, pending_rows_, n_ + 1));
+    return R;
+}
+
+double IncrementalLeastSquares::residualNorm() const {
+    return std::abs(currentR()(n_, n_));
+}
+
+LeastSquaresResult IncrementalLeastSquares::solve() const {
+    if (observations_ < n_) {
+        throw std::runtime_error("IncrementalLeastSquares::solve: Fewer observations than predictors.");
+    }
+    Common::DenseMatrix R = currentR();
+    Common::ConstMatrixView R11 = R.block(0, 0, n_, n_);
+    requireFullRank(R11, "IncrementalLeastSquares::solve");
+
+    LeastSquaresResult result;
+    result.x.resize(n_);
+    for (size_t i = 0; i < n_; ++i) result.x[i] = R(i, n_);
+    backwardSubstitutionInPlace(R11, Common::MatrixView(result.x.data(), n_, 1), Diagonal::NonUnit);
+    result.residual_norm = std::abs(R(n_, n_));
+    return result;
+}
+
+// --- leastSquares ---
+
+LeastSquaresResult leastSquares(Common::ConstMatrixView A, const Common::ValueSeries& b, const QROptions& options) {
+    const size_t m = A.rows(), n = A.cols();
+    if (A.empty() || m < n) {
+        throw std::runtime_error("leastSquares: Matrix is empty or has fewer rows than columns.");
+    }
+    if (b.size() != m) {
+        throw std::runtime_error("leastSquares: Right-hand side size mismatch.");
+    }
+
+    // Niskie lub szerokie układy: zwykły blokowy QR całej macierzy.
+    const size_t chunk = chunkRows(n + 1);
+    if (m < 4 * chunk) {
+        return QRFactorization(A, options).solveLeastSquares(b);
+    }
+
+    // Wysokie układy (m >> n): każdy pas wierszy daje własny czynnik R, łączony na końcu.
+    // Dane są czytane raz, porcjami mieszczącymi się w pamięci podręcznej.
+    const unsigned threads = options.num_threads == 0 ? Common::defaultThreadCount() : options.num_threads;
+    const size_t stripes = std::max<size_t>(1, std::min<size_t>(threads, m / (4 * chunk)));
+    std::vector<IncrementalLeastSquares> parts(stripes, IncrementalLeastSquares(n));
+    Common::parallelFor(0, stripes, threads, [&](size_t s) {
+        const size_t lo = m * s / stripes;
+        const size_t hi = m * (s + 1) / stripes;
+        parts[s].addRows(A.block(lo, 0, hi - lo, n), Common::ValueSeries(b.begin() + lo, b.begin() + hi));
+    });
+    for (size_t s = 1; s < stripes; ++s) parts[0].merge(parts[s]);
+    return parts[0].solve();
+}
+
+LeastSquaresResult leastSquares(const Common::Matrix& A, const Common::ValueSeries& b, const QROptions& options) {
+    return leastSquares(Common::DenseMatrix(A), b, options);
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
@@ -0,0 +1,445 @@
+#include "sparse.hpp"
+#include "parallel.hpp"
+#include "densematrix.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <string>
+#include <cstdint>
+
+namespace MeteoNumerical {
+namespace LinearAlgebra {
+
+namespace {
+// Poniżej tej liczby niezerowych elementów SpMV liczone jest w jednym wątku. Każde mnożenie
+// tworzy wątki od nowa (~15 us na wątek wobec ~1 ns na element), a CG/GMRES mnożą co iterację -
+// dopiero ok. 1 ms pracy szeregowej wyraźnie przeważa koszt uruchomienia kilkunastu wątków.
+constexpr size_t SPMV_PARALLEL_NNZ = 1000000;
+constexpr size_t SPMV_ROW_CHUNK = 2048;
+
+double dot(const Common::ValueSeries& a, const Common::ValueSeries& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+double norm2(const Common::ValueSeries& a) {
+    return std::sqrt(dot(a, a));
+}
+
+// Wspólna konstrukcja formatu skompresowanego: "major" to wiersze dla CSR i kolumny dla CSC.
+void compressTriplets(size_t major_count, size_t minor_count, const std::vector<Triplet>& triplets, bool by_row,
+                      std::vector<size_t>& ptr, std::vector<size_t>& idx, Common::ValueSeries& values) {
+    ptr.assign(major_count + 1, 0);
+    for (const auto& t : triplets) {
+        size_t major = by_row ? t.row : t.col;
+        size_t minor = by_row ? t.col : t.row;
+        if (major >= major_count || minor >= minor_count) {
+            throw std::out_of_range("fromTriplets: Triplet index outside matrix dimensions.");
+        }
+        ptr[major + 1]++;
+    }
+    for (size_t i = 0; i < major_count; ++i) ptr[i + 1] += ptr[i];
+
+    std::vector<size_t> fill(ptr.begin(), ptr.end() - 1);
+    std::vector<std::pair<size_t, double>> entries(triplets.size());
+    for (const auto& t : triplets) {
+        size_t major = by_row ? t.row : t.col;
+        entries[fill[major]++] = {by_row ? t.col : t.row, t.value};
+    }
+
+    idx.clear();
+    values.clear();
+    idx.reserve(entries.size());
+    values.reserve(entries.size());
+    std::vector<size_t> new_ptr(major_count + 1, 0);
+    for (size_t i = 0; i < major_count; ++i) {
+        auto first = entries.begin() + ptr[i];
+        auto last = entries.begin() + ptr[i + 1];
+        std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = first; it != last; ++it) {
+            if (!idx.empty() && idx.size() > new_ptr[i] && idx.back() == it->first) {
+                values.back() += it->second;
+            } else {
+                idx.push_back(it->first);
+                values.push_back(it->second);
+            }
+        }
+        new_ptr[i + 1] = idx.size();
+    }
+    ptr.swap(new_ptr);
+}
+
+void validateCompressed(size_t major_count, size_t minor_count, const std::vector<size_t>& ptr,
+                        const std::vector<size_t>& idx, const Common::ValueSeries& values, const char* where) {
+    if (ptr.size() != major_count + 1 || ptr.front() != 0 || ptr.back() != idx.size() || idx.size() != values.size()) {
+        throw std::runtime_error(std::string(where) + ": Inconsistent compressed storage arrays.");
+    }
+    for (size_t i = 0; i < major_count; ++i) {
+        if (ptr[i] > ptr[i + 1]) {
+            throw std::runtime_error(std::string(where) + ": Pointer array must be non-decreasing.");
+        }
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            if (idx[k] >= minor_count || (k > ptr[i] && idx[k] <= idx[k - 1])) {
+                throw std::runtime_error(std::string(where) + ": Indices must be sorted, unique and in range.");
+            }
+        }
+    }
+}
+} // namespace
+
+// --- CSRMatrix ---
+
+CSRMatrix::CSRMatrix(size_t rows, size_t cols, std::vector<size_t> row_ptr,
+                     std::vector<size_t> col_idx, Common::ValueSeries values)
+        : rows_(rows), cols_(cols), row_ptr_(std::move(row_ptr)), col_idx_(std::move(col_idx)), values_(std::move(values)) {
+    validateCompressed(rows_, cols_, row_ptr_, col_idx_, values_, "CSRMatrix");
+}
+
+CSRMatrix CSRMatrix::fromTriplets(size_t rows, size_t cols, const std::vector<Triplet>& triplets) {
+    CSRMatrix A;
+    A.rows_ = rows;
+    A.cols_ = cols;
+    compressTriplets(rows, cols, triplets, true, A.row_ptr_, A.col_idx_, A.values_);
+    return A;
+}
+
+double CSRMatrix::get(size_t i, size_t j) const {
+    if (i >= rows_ || j >= cols_) {
+        throw std::out_of_range("CSRMatrix::get: Index out of range.");
+    }
+    auto first = col_idx_.begin() + row_ptr_[i];
+    auto last = col_idx_.begin() + row_ptr_[i + 1];
+    auto it = std::lower_bound(first, last, j);
+    return (it != last && *it == j) ? values_[it - col_idx_.begin()] : 0.0;
+}
+
+Common::ValueSeries CSRMatrix::diagonal() const {
+    Common::ValueSeries d(std::min(rows_, cols_), 0.0);
+    for (size_t i = 0; i < d.size(); ++i) d[i] = get(i, i);
+    return d;
+}
+
+void CSRMatrix::multiply(const Common::ValueSeries& x, Common::ValueSeries& y, unsigned num_threads) const {
+    if (x.size() != cols_) {
+        throw std::runtime_error("CSRMatrix::multiply: Vector size mismatch.");
+    }
+    y.resize(rows_);
+    auto rowRange = [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            double sum = 0.0;
+            for (size_t k = row_ptr_[i]; k < row_ptr_[i + 1]; ++k) sum += values_[k] * x[col_idx_[k]];
+            y[i] = sum;
+        }
+    };
+    if (nonZeros() < SPMV_PARALLEL_NNZ) {
+        rowRange(0, rows_);
+    } else {
+        Common::parallelForChunks(0, rows_, SPMV_ROW_CHUNK, num_threads, rowRange);
+    }
+}
+
+Common::ValueSeries CSRMatrix::multiply(const Common::ValueSeries& x, unsigned num_threads) const {
+    Common::ValueSeries y;
+    multiply(x, y, num_threads);
+    return y;
+}
+
+CSCMatrix CSRMatrix::toCSC() const {
+    std::vector<size_t> col_ptr(cols_ + 1, 0);
+    for (size_t c : col_idx_) col_ptr[c + 1]++;
+    for (size_t j = 0; j < cols_; ++j) col_ptr[j + 1] += col_ptr[j];
+    std::vector<size_t> row_idx(nonZeros());
+    Common::ValueSeries vals(nonZeros());
+    std::vector<size_t> fill(col_ptr.begin(), col_ptr.end() - 1);
+    for (size_t i = 0; i < rows_; ++i) {
+        for (size_t k = row_ptr_[i]; k < row_ptr_[i + 1]; ++k) {
+            size_t dst = fill[col_idx_[k]]++;
+            row_idx[dst] = i;
+            vals[dst] = values_[k];
+        }
+    }
+    return CSCMatrix(rows_, cols_, std::move(col_ptr), std::move(row_idx), std::move(vals));
+}
+
+// --- CSCMatrix ---
+
+CSCMatrix::CSCMatrix(size_t rows, size_t cols, std::vector<size_t> col_ptr,
+                     std::vector<size_t> row_idx, Common::ValueSeries values)
+        : rows_(rows), cols_(cols), col_ptr_(std::move(col_ptr)), row_idx_(std::move(row_idx)), values_(std::move(values)) {
+    validateCompressed(cols_, rows_, col_ptr_, row_idx_, values_, "CSCMatrix");
+}
+
+CSCMatrix CSCMatrix::fromTriplets(size_t rows, size_t cols, const std::vector<Triplet>& triplets) {
+    CSCMatrix A;
+    A.rows_ = rows;
+    A.cols_ = cols;
+    compressTriplets(cols, rows, triplets, false, A.col_ptr_, A.row_idx_, A.values_);
+    return A;
+}
+
+Common::ValueSeries CSCMatrix::multiply(const Common::ValueSeries& x) const {
+    if (x.size() != cols_) {
+        throw std::runtime_error("CSCMatrix::multiply: Vector size mismatch.");
+    }
+    Common::ValueSeries y(rows_, 0.0);
+    for (size_t j = 0; j < cols_; ++j) {
+        const double xj = x[j];
+        for (size_t k = col_ptr_[j]; k < col_ptr_[j + 1]; ++k) y[row_idx_[k]] += values_[k] * xj;
+    }
+    return y;
+}
+
+CSRMatrix CSCMatrix::toCSR() const {
+    std::vector<Triplet> triplets;
+    triplets.reserve(nonZeros());
+    for (size_t j = 0; j < cols_; ++j) {
+        for (size_t k = col_ptr_[j]; k < col_ptr_[j + 1]; ++k) triplets.push_back({row_idx_[k], j, values_[k]});
+    }
+    return CSRMatrix::fromTriplets(rows_, cols_, triplets);
+}
+
+// --- Prekondycjonery ---
+
+void IdentityPreconditioner::apply(const Common::ValueSeries& r, Common::ValueSeries& z) const {
+    z = r;
+}
+
+JacobiPreconditioner::JacobiPreconditioner(const CSRMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::runtime_error("JacobiPreconditioner: Matrix must be square.");
+    }
+    inv_diag_ = A.diagonal();
+    for (double& d : inv_diag_) {
+        if (std::abs(d) < Common::DEFAULT_EPSILON) {
+            throw std::runtime_error("JacobiPreconditioner: Zero on the diagonal.");
+        }
+        d = 1.0 / d;
+    }
+}
+
+void JacobiPreconditioner::apply(const Common::ValueSeries& r, Common::ValueSeries& z) const {
+    z.resize(r.size());
+    for (size_t i = 0; i < r.size(); ++i) z[i] = inv_diag_[i] * r[i];
+}
+
+ILU0Preconditioner::ILU0Preconditioner(const CSRMatrix& A) : lu_(A) {
+    const size_t n = A.rows();
+    if (n != A.cols()) {
+        throw std::runtime_error("ILU0Preconditioner: Matrix must be square.");
+    }
+    const auto& ptr = lu_.rowPointers();
+    const auto& col = lu_.columnIndices();
+    // Czynniki L i U powstają w miejscu wartości kopii A
+    Common::ValueSeries& val = lu_.values();
+
+    diag_pos_.assign(n, 0);
+    std::vector<size_t> position(n, SIZE_MAX); // kolumna -> indeks w bieżącym wierszu
+    for (size_t i = 0; i < n; ++i) {
+        bool has_diag = false;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            position[col[k]] = k;
+            if (col[k] == i) {
+                diag_pos_[i] = k;
+                has_diag = true;
+            }
+        }
+        if (!has_diag) {
+            throw std::runtime_error("ILU0Preconditioner: Missing diagonal entry.");
+        }
+        for (size_t k = ptr[i]; k < ptr[i + 1] && col[k] < i; ++k) {
+            const size_t r = col[k];
+            val[k] /= val[diag_pos_[r]];
+            const double l_ir = val[k];
+            for (size_t kk = diag_pos_[r] + 1; kk < ptr[r + 1]; ++kk) {
+                size_t p = position[col[kk]];
+                if (p != SIZE_MAX) val[p] -= l_ir * val[kk];
+            }
+        }
+        if (std::abs(val[diag_pos_[i]]) < Common::DEFAULT_EPSILON) {
+            throw std::runtime_error("ILU0Preconditioner: Zero pivot encountered.");
+        }
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) position[col[k]] = SIZE_MAX;
+    }
+}
+
+void ILU0Preconditioner::apply(const Common::ValueSeries& r, Common::ValueSeries& z) const {
+    const size_t n = lu_.rows();
+    const auto& ptr = lu_.rowPointers();
+    const auto& col = lu_.columnIndices();
+    const auto& val = lu_.values();
+    z = r;
+    for (size_t i = 0; i < n; ++i) {
+        double sum = z[i];
+        for (size_t k = ptr[i]; k < diag_pos_[i]; ++k) sum -= val[k] * z[col[k]];
+        z[i] = sum;
+    }
+    for (size_t i = n; i-- > 0;) {
+        double sum = z[i];
+        for (size_t k = diag_pos_[i] + 1; k < ptr[i + 1]; ++k) sum -= val[k] * z[col[k]];
+        z[i] = sum / val[diag_pos_[i]];
+    }
+}
+
+// --- Solwery iteracyjne ---
+
+namespace {
+void prepareSolve(const CSRMatrix& A, const Common::ValueSeries& b, const IterativeSolverOptions& options,
+                  const char* where, IterativeSolverResult& result, Common::ValueSeries& r) {
+    if (A.rows() != A.cols() || b.size() != A.rows()) {
+        throw std::runtime_error(std::string(where) + ": Invalid matrix or vector dimensions.");
+    }
+    if (!options.initial_guess.empty() && options.initial_guess.size() != b.size()) {
+        throw std::runtime_error(std::string(where) + ": Initial guess size mismatch.");
+    }
+    result = IterativeSolverResult();
+    result.x = options.initial_guess.empty() ? Common::ValueSeries(b.size(), 0.0) : options.initial_guess;
+    A.multiply(result.x, r, options.num_threads);
+    for (size_t i = 0; i < b.size(); ++i) r[i] = b[i] - r[i];
+    result.residual_norm = norm2(r);
+    result.residual_history.push_back(result.residual_norm);
+}
+} // namespace
+
+IterativeSolverResult conjugateGradient(const CSRMatrix& A, const Common::ValueSeries& b,
+                                        const Preconditioner& preconditioner,
+                                        const IterativeSolverOptions& options) {
+    IterativeSolverResult result;
+    Common::ValueSeries r;
+    prepareSolve(A, b, options, "conjugateGradient", result, r);
+    const double target = options.tolerance * norm2(b);
+    if (result.residual_norm <= target) {
+        result.converged = true;
+        return result;
+    }
+
+    Common::ValueSeries z, p, Ap;
+    preconditioner.apply(r, z);
+    p = z;
+    double rz = dot(r, z);
+    Common::ValueSeries& x = result.x;
+    for (int it = 0; it < options.max_iterations; ++it) {
+        A.multiply(p, Ap, options.num_threads);
+        const double pAp = dot(p, Ap);
+        if (pAp <= 0.0) {
+            throw std::runtime_error("conjugateGradient: Matrix is not positive definite.");
+        }
+        const double alpha = rz / pAp;
+        for (size_t i = 0; i < x.size(); ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+        }
+        result.iterations = it + 1;
+        result.residual_norm = norm2(r);
+        result.residual_history.push_back(result.residual_norm);
+        if (result.residual_norm <= target) {
+            result.converged = true;
+            break;
+        }
+        preconditioner.apply(r, z);
+        const double rz_new = dot(r, z);
+        const double beta = rz_new / rz;
+        rz = rz_new;
+        for (size_t i = 0; i < p.size(); ++i) p[i] = z[i] + beta * p[i];
+    }
+    return result;
+}
+
+IterativeSolverResult conjugateGradient(const CSRMatrix& A, const Common::ValueSeries& b,
+                                        const IterativeSolverOptions& options) {
+    return conjugateGradient(A, b, IdentityPreconditioner(), options);
+}
+
+IterativeSolverResult gmres(const CSRMatrix& A, const Common::ValueSeries& b,
+                            const Preconditioner& preconditioner,
+                            const IterativeSolverOptions& options) {
+    if (options.restart <= 0) {
+        throw std::runtime_error("gmres: Restart length must be positive.");
+    }
+    IterativeSolverResult result;
+    Common::ValueSeries r;
+    prepareSolve(A, b, options, "gmres", result, r);
+    const double target = options.tolerance * norm2(b);
+    if (result.residual_norm <= target) {
+        result.converged = true;
+        return result;
+    }
+
+    const size_t n = b.size();
+    const size_t m = static_cast<size_t>(options.restart);
+    std::vector<Common::ValueSeries> V(m + 1, Common::ValueSeries(n));
+    Common::DenseMatrix H(m + 1, m, 0.0);
+    Common::ValueSeries cs(m), sn(m), g(m + 1), y(m), z, w, update(n);
+    Common::ValueSeries& x = result.x;
+
+    while (result.iterations < options.max_iterations && !result.converged) {
+        const double beta = result.residual_norm;
+        for (size_t i = 0; i < n; ++i) V[0][i] = r[i] / beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        size_t k = 0; // liczba kolumn bazy Kryłowa w bieżącym cyklu
+        while (k < m && result.iterations < options.max_iterations) {
+            preconditioner.apply(V[k], z);
+            A.multiply(z, w, options.num_threads);
+            // Zmodyfikowana ortogonalizacja Grama-Schmidta
+            for (size_t i = 0; i <= k; ++i) {
+                H(i, k) = dot(w, V[i]);
+                for (size_t t = 0; t < n; ++t) w[t] -= H(i, k) * V[i][t];
+            }
+            H(k + 1, k) = norm2(w);
+            if (H(k + 1, k) > 0.0) {
+                for (size_t t = 0; t < n; ++t) V[k + 1][t] = w[t] / H(k + 1, k);
+            }
+            // Poprzednie obroty Givensa, potem nowy zerujący H(k+1, k)
+            for (size_t i = 0; i < k; ++i) {
+                double h0 = H(i, k), h1 = H(i + 1, k);
+                H(i, k) = cs[i] * h0 + sn[i] * h1;
+                H(i + 1, k) = -sn[i] * h0 + cs[i] * h1;
+            }
+            double denom = std::hypot(H(k, k), H(k + 1, k));
+            cs[k] = denom > 0.0 ? H(k, k) / denom : 1.0;
+            sn[k] = denom > 0.0 ? H(k + 1, k) / denom : 0.0;
+            H(k, k) = denom;
+            H(k + 1, k) = 0.0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+
+            ++k;
+            result.iterations++;
+            result.residual_norm = std::abs(g[k]);
+            result.residual_history.push_back(result.residual_norm);
+            if (result.residual_norm <= target || denom == 0.0) break;
+        }
+
+        // y = H^{-1} g, x += M^{-1} V y
+        for (size_t i = k; i-- > 0;) {
+            double sum = g[i];
+            for (size_t j = i + 1; j < k; ++j) sum -= H(i, j) * y[j];
+            y[i] = H(i, i) != 0.0 ? sum / H(i, i) : 0.0;
+        }
+        std::fill(update.begin(), update.end(), 0.0);
+        for (size_t j = 0; j < k; ++j) {
+            for (size_t t = 0; t < n; ++t) update[t] += y[j] * V[j][t];
+        }
+        preconditioner.apply(update, z);
+        for (size_t t = 0; t < n; ++t) x[t] += z[t];
+
+        // Prawdziwe residuum na koniec cyklu
+        A.multiply(x, r, options.num_threads);
+        for (size_t i = 0; i < n; ++i) r[i] = b[i] - r[i];
+        result.residual_norm = norm2(r);
+        if (result.residual_norm <= target) result.converged = true;
+        else if (result.residual_norm == 0.0) break;
+    }
+    return result;
+}
+
+IterativeSolverResult gmres(const CSRMatrix& A, const Common::ValueSeries& b,
+                            const IterativeSolverOptions& options) {
+    return gmres(A, b, IdentityPreconditioner(), options);
+}
+
+} // namespace LinearAlgebra
+} // namespace MeteoNumerical
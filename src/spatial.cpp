@@ -0,0 +1,257 @@
+#include "spatial.hpp"
+#include "parallel.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+namespace {
+
+// Zakresy nie większe niż LEAF_SIZE są przeszukiwane liniowo.
+const size_t LEAF_SIZE = 8;
+// Pole startowe komórki Voronoi: kwadrat o połowie boku BOX_SCALE * (odległość najdalszego kandydata).
+const double BOX_SCALE = 1e3;
+
+} // namespace
+
+KDTree2D::KDTree2D(const std::vector<DataStructures::StationLocation>& points) {
+    for (const auto& p : points) {
+        if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+            throw std::runtime_error("KDTree2D: station coordinates must be finite.");
+        }
+    }
+    ids_.resize(points.size());
+    std::iota(ids_.begin(), ids_.end(), size_t(0));
+    split_.assign(points.size(), 0);
+    build(points, 0, points.size());
+    points_.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) points_[i] = points[ids_[i]];
+}
+
+void KDTree2D::build(const std::vector<DataStructures::StationLocation>& input, size_t lo, size_t hi) {
+    if (hi - lo <= LEAF_SIZE) return;
+    double min_x = input[ids_[lo]].x, max_x = min_x, min_y = input[ids_[lo]].y, max_y = min_y;
+    for (size_t i = lo + 1; i < hi; ++i) {
+        const auto& p = input[ids_[i]];
+        min_x = std::min(min_x, p.x);
+        max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+    const unsigned char axis = (max_x - min_x >= max_y - min_y) ? 0 : 1;
+    const size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(ids_.begin() + lo, ids_.begin() + mid, ids_.begin() + hi, [&](size_t a, size_t b) {
+        return axis == 0 ? input[a].x < input[b].x : input[a].y < input[b].y;
+    });
+    split_[mid] = axis;
+    build(input, lo, mid);
+    build(input, mid + 1, hi);
+}
+
+void KDTree2D::search(size_t lo, size_t hi, double x, double y, size_t k, Neighbor* out, size_t& count) const {
+    // Lista out jest posortowana rosnąco; nowy kandydat wchodzi przez wstawianie (k jest małe).
+    auto consider = [&](size_t i) {
+        const double dx = points_[i].x - x, dy = points_[i].y - y;
+        const double d = dx * dx + dy * dy;
+        if (count == k && !(d < out[k - 1].distance_sq)) return;
+        size_t pos = count < k ? count++ : k - 1;
+        while (pos > 0 && out[pos - 1].distance_sq > d) {
+            out[pos] = out[pos - 1];
+            --pos;
+        }
+        out[pos] = Neighbor{ids_[i], d};
+    };
+
+    if (hi - lo <= LEAF_SIZE) {
+        for (size_t i = lo; i < hi; ++i) consider(i);
+        return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    const double diff = split_[mid] == 0 ? x - points_[mid].x : y - points_[mid].y;
+    if (diff < 0.0) {
+        search(lo, mid, x, y, k, out, count);
+    } else {
+        search(mid + 1, hi, x, y, k, out, count);
+    }
+    consider(mid);
+    if (count < k || diff * diff < out[k - 1].distance_sq) {
+        if (diff < 0.0) {
+            search(mid + 1, hi, x, y, k, out, count);
+        } else {
+            search(lo, mid, x, y, k, out, count);
+        }
+    }
+}
+
+size_t KDTree2D::nearest(double x, double y, size_t k, Neighbor* out) const {
+    k = std::min(k, points_.size());
+    size_t count = 0;
+    if (k > 0) search(0, points_.size(), x, y, k, out, count);
+    return count;
+}
+
+std::vector<Neighbor> KDTree2D::nearest(double x, double y, size_t k) const {
+    std::vector<Neighbor> out(std::min(k, points_.size()));
+    out.resize(nearest(x, y, k, out.data()));
+    return out;
+}
+
+// Bufory jednego wątku, używane ponownie dla kolejnych punktów.
+struct SpatialInterpolator::Scratch {
+    std::vector<Neighbor> neighbors;
+    std::vector<double> vx, vy, nx, ny; // wierzchołki komórki przed i po przycięciu
+    std::vector<long> label, nlabel;    // krawędź i -> i+1 leży na dwusiecznej z kandydatem label[i] (-1: brzeg pola)
+    std::vector<double> weights;
+};
+
+SpatialInterpolator::SpatialInterpolator(const std::vector<DataStructures::StationLocation>& stations,
+                                         const Common::ValueSeries& values)
+        : locations_(stations), tree_(stations) {
+    if (stations.empty()) {
+        throw std::runtime_error("SpatialInterpolator: at least one station is required.");
+    }
+    setValues(values);
+}
+
+void SpatialInterpolator::setValues(const Common::ValueSeries& values) {
+    if (values.size() != locations_.size()) {
+        throw std::runtime_error("SpatialInterpolator::setValues: one value per station is required.");
+    }
+    for (double v : values) {
+        if (!std::isfinite(v)) {
+            throw std::runtime_error("SpatialInterpolator::setValues: values must be finite.");
+        }
+    }
+    values_ = values;
+}
+
+double SpatialInterpolator::inverseDistance(const Neighbor* neighbors, size_t count, double power) const {
+    double weighted = 0.0, total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const double w = power == 2.0 ? 1.0 / neighbors[i].distance_sq
+                                      : std::pow(neighbors[i].distance_sq, -0.5 * power);
+        weighted += w * values_[neighbors[i].index];
+        total += w;
+    }
+    return weighted / total;
+}
+
+double SpatialInterpolator::naturalNeighbor(double x, double y, const Neighbor* neighbors, size_t count,
+                                            Scratch& s) const {
+    // Komórka Voronoi punktu (x, y) względem kandydatów: duży kwadrat przycinany kolejno półpłaszczyznami
+    // "bliżej (x, y) niż stacji j" (Sutherland-Hodgman); każda krawędź pamięta, z której dwusiecznej pochodzi.
+    const double R = BOX_SCALE * std::sqrt(neighbors[count - 1].distance_sq);
+    s.vx.assign({x - R, x + R, x + R, x - R});
+    s.vy.assign({y - R, y - R, y + R, y + R});
+    s.label.assign(4, -1);
+    for (size_t j = 0; j < count; ++j) {
+        const auto& p = locations_[neighbors[j].index];
+        const double ux = p.x - x, uy = p.y - y;
+        const double mx = 0.5 * (p.x + x), my = 0.5 * (p.y + y);
+        auto side = [&](size_t i) { return (s.vx[i] - mx) * ux + (s.vy[i] - my) * uy; };
+        const size_t m = s.vx.size();
+        bool clipped = false;
+        for (size_t i = 0; i < m && !clipped; ++i) clipped = side(i) > 0.0;
+        if (!clipped) continue; // dwusieczna nie przecina komórki - stacja nie jest naturalnym sąsiadem
+
+        s.nx.clear();
+        s.ny.clear();
+        s.nlabel.clear();
+        for (size_t i = 0; i < m; ++i) {
+            const size_t next = i + 1 == m ? 0 : i + 1;
+            const double sa = side(i), sb = side(next);
+            if (sa <= 0.0) {
+                s.nx.push_back(s.vx[i]);
+                s.ny.push_back(s.vy[i]);
+                s.nlabel.push_back(s.label[i]);
+            }
+            if ((sa <= 0.0) != (sb <= 0.0)) {
+                const double t = sa / (sa - sb);
+                s.nx.push_back(s.vx[i] + t * (s.vx[next] - s.vx[i]));
+                s.ny.push_back(s.vy[i] + t * (s.vy[next] - s.vy[i]));
+                // wyjście z półpłaszczyzny: dalej biegnie nowa krawędź; wejście: reszta starej
+                s.nlabel.push_back(sa <= 0.0 ? static_cast<long>(j) : s.label[i]);
+            }
+        }
+        s.vx.swap(s.nx);
+        s.vy.swap(s.ny);
+        s.label.swap(s.nlabel);
+    }
+
+    // Wagi Laplace'a: długość wspólnej krawędzi / odległość do stacji
+    s.weights.assign(count, 0.0);
+    const size_t m = s.vx.size();
+    for (size_t i = 0; i < m; ++i) {
+        if (s.label[i] < 0) continue;
+        const size_t next = i + 1 == m ? 0 : i + 1;
+        const double length = std::hypot(s.vx[next] - s.vx[i], s.vy[next] - s.vy[i]);
+        s.weights[s.label[i]] += length / std::sqrt(neighbors[s.label[i]].distance_sq);
+    }
+    double weighted = 0.0, total = 0.0;
+    for (size_t j = 0; j < count; ++j) {
+        weighted += s.weights[j] * values_[neighbors[j].index];
+        total += s.weights[j];
+    }
+    return total > 0.0 ? weighted / total : inverseDistance(neighbors, count, 2.0);
+}
+
+double SpatialInterpolator::evaluate(double x, double y, SpatialMethod method,
+                                     const SpatialInterpolationOptions& options, Scratch& scratch) const {
+    scratch.neighbors.resize(options.neighbors);
+    size_t count = tree_.nearest(x, y, options.neighbors, scratch.neighbors.data());
+    const double max_sq = options.max_distance * options.max_distance;
+    while (count > 0 && scratch.neighbors[count - 1].distance_sq > max_sq) --count;
+    if (count == 0) return std::numeric_limits<double>::quiet_NaN();
+    if (scratch.neighbors[0].distance_sq == 0.0) return values_[scratch.neighbors[0].index];
+    if (method == SpatialMethod::NaturalNeighbor) {
+        return naturalNeighbor(x, y, scratch.neighbors.data(), count, scratch);
+    }
+    return inverseDistance(scratch.neighbors.data(), count, options.power);
+}
+
+namespace {
+
+void validateOptions(const SpatialInterpolationOptions& options, const char* where) {
+    if (options.neighbors == 0 || !(options.power > 0.0) || !(options.max_distance > 0.0)) {
+        throw std::runtime_error(std::string(where) + ": neighbors, power and max_distance must be positive.");
+    }
+}
+
+} // namespace
+
+double SpatialInterpolator::evaluate(double x, double y, SpatialMethod method,
+                                     const SpatialInterpolationOptions& options) const {
+    validateOptions(options, "SpatialInterpolator::evaluate");
+    Scratch scratch;
+    return evaluate(x, y, method, options, scratch);
+}
+
+Common::DenseMatrix SpatialInterpolator::fillGrid(const RegularGrid2D& grid, SpatialMethod method,
+                                                  const SpatialInterpolationOptions& options) const {
+    validateOptions(options, "SpatialInterpolator::fillGrid");
+    if (!(grid.dx > 0.0) || !(grid.dy > 0.0) || !std::isfinite(grid.x0) || !std::isfinite(grid.y0)) {
+        throw std::runtime_error("SpatialInterpolator::fillGrid: grid steps must be positive and origin finite.");
+    }
+    Common::DenseMatrix result(grid.ny, grid.nx);
+    // Około 8 porcji wierszy na wątek: wyrównuje obciążenie, a bufory Scratch służą wielu wierszom.
+    const unsigned threads = options.num_threads == 0 ? Common::defaultThreadCount() : options.num_threads;
+    const size_t chunk = std::max<size_t>(1, grid.ny / (8 * static_cast<size_t>(threads)));
+    Common::parallelForChunks(0, grid.ny, chunk, threads, [&](size_t lo, size_t hi) {
+        Scratch scratch;
+        for (size_t j = lo; j < hi; ++j) {
+            const double y = grid.y0 + static_cast<double>(j) * grid.dy;
+            double* row = result.rowPtr(j);
+            for (size_t i = 0; i < grid.nx; ++i) {
+                row[i] = evaluate(grid.x0 + static_cast<double>(i) * grid.dx, y, method, options, scratch);
+            }
+        }
+    });
+    return result;
+}
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
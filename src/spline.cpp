@@ -0,0 +1,223 @@
+#include "spline.hpp"
+#include "banded.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+namespace {
+
+// Względna tolerancja, z jaką kroki siatki uznajemy za równe.
+const double UNIFORM_TOLERANCE = 1e-10;
+
+} // namespace
+
+CubicSpline::CubicSpline(const Common::ValueSeries& x, const Common::ValueSeries& y, SplineBoundary boundary,
+                         double left_slope, double right_slope) {
+    if (x.size() != y.size() || x.size() < 2) {
+        throw std::runtime_error("CubicSpline: x and y must have the same size of at least 2.");
+    }
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i])) {
+            throw std::runtime_error("CubicSpline: nodes and values must be finite.");
+        }
+        if (i > 0 && !(x[i] > x[i - 1])) {
+            throw std::runtime_error("CubicSpline: x must be strictly increasing.");
+        }
+    }
+    nodes_ = x;
+    build(y, boundary, left_slope, right_slope);
+}
+
+CubicSpline CubicSpline::uniform(double x0, double step, const Common::ValueSeries& y, SplineBoundary boundary,
+                                 double left_slope, double right_slope) {
+    if (!(step > 0.0) || !std::isfinite(x0)) {
+        throw std::runtime_error("CubicSpline::uniform: step must be positive and x0 finite.");
+    }
+    Common::ValueSeries x(y.size());
+    for (size_t i = 0; i < x.size(); ++i) x[i] = x0 + static_cast<double>(i) * step;
+    return CubicSpline(x, y, boundary, left_slope, right_slope);
+}
+
+void CubicSpline::build(const Common::ValueSeries& y, SplineBoundary boundary, double left_slope, double right_slope) {
+    const size_t n = nodes_.size();
+    Common::ValueSeries h(n - 1), slope(n - 1), M(n, 0.0);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        h[i] = nodes_[i + 1] - nodes_[i];
+        slope[i] = (y[i + 1] - y[i]) / h[i];
+    }
+
+    if (boundary == SplineBoundary::Clamped) {
+        // Niewiadome M_0..M_{n-1}; pierwszy i ostatni wiersz wynikają z zadanych pochodnych.
+        Common::ValueSeries lower(n - 1), diag(n), upper(n - 1), work(n);
+        diag[0] = 2.0 * h[0];
+        upper[0] = h[0];
+        M[0] = 6.0 * (slope[0] - left_slope);
+        for (size_t i = 1; i + 1 < n; ++i) {
+            lower[i - 1] = h[i - 1];
+            diag[i] = 2.0 * (h[i - 1] + h[i]);
+            upper[i] = h[i];
+            M[i] = 6.0 * (slope[i] - slope[i - 1]);
+        }
+        lower[n - 2] = h[n - 2];
+        diag[n - 1] = 2.0 * h[n - 2];
+        M[n - 1] = 6.0 * (right_slope - slope[n - 2]);
+        LinearAlgebra::thomasSolveInPlace(n, lower.data(), diag.data(), upper.data(), M.data(), work.data());
+    } else if (boundary == SplineBoundary::NotAKnot && n == 3) {
+        // Jedyny wielomian stopnia 2 przez trzy punkty
+        const double second = 2.0 * (slope[1] - slope[0]) / (h[0] + h[1]);
+        std::fill(M.begin(), M.end(), second);
+    } else if (n > 2 && (boundary == SplineBoundary::Natural || boundary == SplineBoundary::NotAKnot)) {
+        // Niewiadome M_1..M_{n-2}. Dla not-a-knot M_0 i M_{n-1} są wyrugowane z pierwszego
+        // i ostatniego wiersza, więc układ pozostaje trójdiagonalny i diagonalnie dominujący.
+        const size_t m = n - 2;
+        Common::ValueSeries lower(m > 1 ? m - 1 : 0), diag(m), upper(m > 1 ? m - 1 : 0), work(m);
+        double* rhs = M.data() + 1;
+        for (size_t r = 0; r < m; ++r) {
+            const size_t i = r + 1;
+            diag[r] = 2.0 * (h[i - 1] + h[i]);
+            if (r > 0) lower[r - 1] = h[i - 1];
+            if (r + 1 < m) upper[r] = h[i];
+            rhs[r] = 6.0 * (slope[i] - slope[i - 1]);
+        }
+        if (boundary == SplineBoundary::NotAKnot) {
+            const double h0 = h[0], h1 = h[1];
+            diag[0] = (h0 + h1) * (h0 + 2.0 * h1) / h1;
+            if (m > 1) upper[0] = (h1 * h1 - h0 * h0) / h1;
+            const double a = h[n - 3], b = h[n - 2];
+            if (m > 1) {
+                diag[m - 1] = (a + b) * (2.0 * a + b) / a;
+                lower[m - 2] = (a * a - b * b) / a;
+            }
+        }
+        LinearAlgebra::thomasSolveInPlace(m, lower.data(), diag.data(), upper.data(), rhs, work.data());
+        if (boundary == SplineBoundary::NotAKnot) {
+            M[0] = ((h[0] + h[1]) * M[1] - h[0] * M[2]) / h[1];
+            const double a = h[n - 3], b = h[n - 2];
+            M[n - 1] = ((a + b) * M[n - 2] - b * M[n - 3]) / a;
+        }
+    }
+    // n == 2 bez zadanych pochodnych: odcinek prostej (M = 0)
+
+    segments_.resize(n - 1);
+    cumulative_.assign(n, 0.0);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        Segment& s = segments_[i];
+        s.x = nodes_[i];
+        s.a = y[i];
+        s.b = slope[i] - h[i] * (2.0 * M[i] + M[i + 1]) / 6.0;
+        s.c = 0.5 * M[i];
+        s.d = (M[i + 1] - M[i]) / (6.0 * h[i]);
+        const double t = h[i];
+        cumulative_[i + 1] = cumulative_[i] + t * (s.a + t * (s.b / 2.0 + t * (s.c / 3.0 + t * s.d / 4.0)));
+    }
+
+    const double step = (nodes_[n - 1] - nodes_[0]) / static_cast<double>(n - 1);
+    uniform_ = true;
+    for (size_t i = 0; i + 1 < n && uniform_; ++i) {
+        if (std::abs(h[i] - step) > UNIFORM_TOLERANCE * step) uniform_ = false;
+    }
+    inv_step_ = uniform_ ? 1.0 / step : 0.0;
+}
+
+void CubicSpline::requireBuilt(const char* where) const {
+    if (segments_.empty()) {
+        throw std::runtime_error(std::string(where) + ": spline has no nodes.");
+    }
+}
+
+size_t CubicSpline::findSegment(double x) const {
+    const size_t last = segments_.size() - 1;
+    if (uniform_) {
+        const double t = (x - nodes_[0]) * inv_step_;
+        if (!(t > 0.0)) return 0;
+        return t >= static_cast<double>(last) ? last : static_cast<size_t>(t);
+    }
+    // Bezgałęziowe wyszukiwanie binarne: warunek daje cmov zamiast skoku, a obie możliwe
+    // następne połowy są pobierane z wyprzedzeniem.
+    const double* base = nodes_.data();
+    size_t len = last + 1;
+    while (len > 1) {
+        const size_t half = len / 2;
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base = (base[half] <= x) ? base + half : base;
+        len -= half;
+    }
+    return static_cast<size_t>(base - nodes_.data());
+}
+
+size_t CubicSpline::nextSegment(size_t hint, double x) const {
+    if (!uniform_) {
+        const size_t last = segments_.size() - 1;
+        for (size_t i = hint; i <= std::min(hint + 1, last); ++i) {
+            if (x >= nodes_[i] && (i == last || x < nodes_[i + 1])) return i;
+        }
+    }
+    return findSegment(x);
+}
+
+double CubicSpline::evaluate(double x) const {
+    requireBuilt("CubicSpline::evaluate");
+    const Segment& s = segments_[findSegment(x)];
+    const double t = x - s.x;
+    return s.a + t * (s.b + t * (s.c + t * s.d));
+}
+
+double CubicSpline::derivative(double x) const {
+    requireBuilt("CubicSpline::derivative");
+    const Segment& s = segments_[findSegment(x)];
+    const double t = x - s.x;
+    return s.b + t * (2.0 * s.c + t * 3.0 * s.d);
+}
+
+double CubicSpline::secondDerivative(double x) const {
+    requireBuilt("CubicSpline::secondDerivative");
+    const Segment& s = segments_[findSegment(x)];
+    return 2.0 * s.c + 6.0 * s.d * (x - s.x);
+}
+
+double CubicSpline::integral(double a, double b) const {
+    requireBuilt("CubicSpline::integral");
+    auto primitive = [this](double x) {
+        const size_t i = findSegment(x);
+        const Segment& s = segments_[i];
+        const double t = x - s.x;
+        return cumulative_[i] + t * (s.a + t * (s.b / 2.0 + t * (s.c / 3.0 + t * s.d / 4.0)));
+    };
+    return primitive(b) - primitive(a);
+}
+
+void CubicSpline::evaluate(const double* x, double* out, size_t count) const {
+    requireBuilt("CubicSpline::evaluate");
+    size_t segment = 0;
+    for (size_t k = 0; k < count; ++k) {
+        segment = nextSegment(segment, x[k]);
+        const Segment& s = segments_[segment];
+        const double t = x[k] - s.x;
+        out[k] = s.a + t * (s.b + t * (s.c + t * s.d));
+    }
+}
+
+Common::ValueSeries CubicSpline::evaluate(const Common::ValueSeries& x) const {
+    Common::ValueSeries out(x.size());
+    evaluate(x.data(), out.data(), x.size());
+    return out;
+}
+
+void CubicSpline::derivative(const double* x, double* out, size_t count) const {
+    requireBuilt("CubicSpline::derivative");
+    size_t segment = 0;
+    for (size_t k = 0; k < count; ++k) {
+        segment = nextSegment(segment, x[k]);
+        const Segment& s = segments_[segment];
+        const double t = x[k] - s.x;
+        out[k] = s.b + t * (2.0 * s.c + t * 3.0 * s.d);
+    }
+}
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
@@ -0,0 +1,136 @@
+#include "streaming.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MeteoNumerical {
+namespace Interpolation {
+
+SlidingWindowInterpolator::SlidingWindowInterpolator(size_t window, StreamingScheme scheme)
+        : window_(window), scheme_(scheme) {
+    if (window < 2) {
+        throw std::runtime_error("SlidingWindowInterpolator: window must hold at least 2 samples.");
+    }
+    times_.assign(2 * window, 0.0);
+    values_.assign(2 * window, 0.0);
+    if (scheme == StreamingScheme::WindowNewton) newton_.assign(window, 0.0);
+}
+
+void SlidingWindowInterpolator::clear() {
+    head_ = 0;
+    count_ = 0;
+}
+
+double SlidingWindowInterpolator::oldestTime() const {
+    requireSamples("SlidingWindowInterpolator::oldestTime");
+    return times_[head_];
+}
+
+double SlidingWindowInterpolator::newestTime() const {
+    requireSamples("SlidingWindowInterpolator::newestTime");
+    return times_[head_ + count_ - 1];
+}
+
+void SlidingWindowInterpolator::requireSamples(const char* where) const {
+    if (count_ == 0) {
+        throw std::runtime_error(std::string(where) + ": window is empty.");
+    }
+}
+
+void SlidingWindowInterpolator::push(double t, double value) {
+    if (!std::isfinite(t) || !std::isfinite(value)) {
+        throw std::runtime_error("SlidingWindowInterpolator::push: time and value must be finite.");
+    }
+    if (count_ > 0 && !(t > times_[head_ + count_ - 1])) {
+        throw std::runtime_error("SlidingWindowInterpolator::push: time must be strictly increasing.");
+    }
+
+    if (scheme_ == StreamingScheme::WindowNewton) {
+        // Węzły od najnowszego: f[x_{n+1}, ..., x_{n+1-j}] = (f[x_{n+1}, ..., x_{n+2-j}] - f[x_n, ..., x_{n+1-j}])
+        // / (x_{n+1} - x_{n+1-j}); stare ilorazy są nadpisywane w miejscu, najstarszy węzeł wypada sam.
+        const size_t m = std::min(count_ + 1, window_);
+        const double* x = times_.data() + head_; // x_{n+1-j} = x[count_ - j]
+        double carry = value;
+        for (size_t j = 1; j < m; ++j) {
+            const double previous = newton_[j - 1];
+            newton_[j - 1] = carry;
+            carry = (carry - previous) / (t - x[count_ - j]);
+        }
+        newton_[m - 1] = carry;
+    }
+
+    size_t slot;
+    if (count_ < window_) {
+        slot = (head_ + count_) % window_;
+        ++count_;
+    } else {
+        slot = head_;
+        head_ = (head_ + 1) % window_;
+    }
+    times_[slot] = times_[slot + window_] = t;
+    values_[slot] = values_[slot + window_] = value;
+}
+
+size_t SlidingWindowInterpolator::locate(double t, size_t hint) const {
+    // Indeks i przedziału [t_i, t_{i+1}] okna: zgadywanie z średniego kroku (lub podpowiedzi),
+    // potem krótki marsz - dla równomiernego próbkowania kilka porównań.
+    const double* x = times_.data() + head_;
+    const size_t last = count_ - 2;
+    size_t i = hint;
+    if (hint > last) {
+        const double step = (x[count_ - 1] - x[0]) / static_cast<double>(count_ - 1);
+        const double guess = (t - x[0]) / step;
+        i = guess >= static_cast<double>(last) ? last : (guess > 0.0 ? static_cast<size_t>(guess) : 0);
+    }
+    while (i > 0 && t < x[i]) --i;
+    while (i < last && t >= x[i + 1]) ++i;
+    return i;
+}
+
+double SlidingWindowInterpolator::evaluateLocal(double t, size_t segment) const {
+    // Szablon 4 próbek: dwie po lewej i dwie po prawej, przesunięty przy brzegach okna.
+    const size_t points = std::min<size_t>(4, count_);
+    size_t first = segment > 0 ? segment - 1 : 0;
+    first = std::min(first, count_ - points);
+    const double* x = times_.data() + head_ + first;
+    const double* y = values_.data() + head_ + first;
+    double d[4];
+    for (size_t i = 0; i < points; ++i) d[i] = y[i];
+    for (size_t level = 1; level < points; ++level) {
+        for (size_t i = points - 1; i >= level; --i) d[i] = (d[i] - d[i - 1]) / (x[i] - x[i - level]);
+    }
+    double result = d[points - 1];
+    for (size_t i = points - 1; i-- > 0;) result = result * (t - x[i]) + d[i];
+    return result;
+}
+
+double SlidingWindowInterpolator::evaluateNewton(double t) const {
+    const double* x = times_.data() + head_; // j-ta od najnowszej próbka to x[count_ - 1 - j]
+    double result = newton_[count_ - 1];
+    for (size_t j = count_ - 1; j-- > 0;) result = result * (t - x[count_ - 1 - j]) + newton_[j];
+    return result;
+}
+
+double SlidingWindowInterpolator::evaluate(double t) const {
+    requireSamples("SlidingWindowInterpolator::evaluate");
+    if (count_ == 1) return values_[head_];
+    if (scheme_ == StreamingScheme::WindowNewton) return evaluateNewton(t);
+    return evaluateLocal(t, locate(t, count_));
+}
+
+void SlidingWindowInterpolator::evaluate(const double* t, double* out, size_t count) const {
+    requireSamples("SlidingWindowInterpolator::evaluate");
+    if (count_ == 1 || scheme_ == StreamingScheme::WindowNewton) {
+        for (size_t k = 0; k < count; ++k) out[k] = evaluate(t[k]);
+        return;
+    }
+    size_t segment = count_; // brak podpowiedzi przy pierwszym punkcie
+    for (size_t k = 0; k < count; ++k) {
+        segment = locate(t[k], segment);
+        out[k] = evaluateLocal(t[k], segment);
+    }
+}
+
+} // namespace Interpolation
+} // namespace MeteoNumerical
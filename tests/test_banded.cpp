@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "banded.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeteoNumerical;
+
+// Układ -x[i-1] + 4x[i] - x[i+1] = d[i] o znanym rozwiązaniu
+TEST(BandedTest, ThomasSolvesDiagonallyDominantSystem) {
+    const size_t n = 1000;
+    Common::ValueSeries lower(n - 1, -1.0), diag(n, 4.0), upper(n - 1, -1.0), x_true(n), d(n);
+    for (size_t i = 0; i < n; ++i) x_true[i] = std::cos(0.01 * i);
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = 4.0 * x_true[i];
+        if (i > 0) d[i] -= x_true[i - 1];
+        if (i + 1 < n) d[i] -= x_true[i + 1];
+    }
+
+    Common::ValueSeries x = LinearAlgebra::thomasSolve(lower, diag, upper, d);
+    for (size_t i = 0; i < n; ++i) ASSERT_NEAR(x[i], x_true[i], 1e-12);
+
+    EXPECT_THROW(LinearAlgebra::thomasSolve(lower, diag, upper, Common::ValueSeries(n - 1)), std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::thomasSolve({1.0}, {0.0, 1.0}, {1.0}, {1.0, 1.0}), std::runtime_error);
+}
+
+TEST(BandedTest, BatchedThomasMatchesSingleSystemSolves) {
+    const size_t n = 50, batch = 37;
+    Common::ValueSeries lower((n - 1) * batch), diag(n * batch), upper((n - 1) * batch), rhs(n * batch);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t s = 0; s < batch; ++s) {
+            diag[i * batch + s] = 3.0 + 0.1 * s;
+            rhs[i * batch + s] = std::sin(0.3 * i + s);
+            if (i + 1 < n) {
+                lower[i * batch + s] = -1.0 + 0.01 * i;
+                upper[i * batch + s] = 0.5 - 0.02 * s;
+            }
+        }
+    }
+    Common::ValueSeries solution = rhs;
+    LinearAlgebra::thomasSolveBatched(n, batch, lower.data(), diag.data(), upper.data(), solution.data(), 3);
+
+    for (size_t s = 0; s < batch; ++s) {
+        Common::ValueSeries a(n - 1), b(n), c(n - 1), d(n);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = diag[i * batch + s];
+            d[i] = rhs[i * batch + s];
+            if (i + 1 < n) {
+                a[i] = lower[i * batch + s];
+                c[i] = upper[i * batch + s];
+            }
+        }
+        Common::ValueSeries x = LinearAlgebra::thomasSolve(a, b, c, d);
+        for (size_t i = 0; i < n; ++i) ASSERT_NEAR(solution[i * batch + s], x[i], 1e-13);
+    }
+}
+
+TEST(BandedTest, BandedLUWithPivotingSolvesSystemThomasCannot) {
+    // Zero na przekątnej wymusza zamianę wierszy
+    Common::Matrix dense = {
+        {0, 2, 1, 0, 0, 0},
+        {1, 1, 0, 3, 0, 0},
+        {2, 0, 4, 1, 1, 0},
+        {0, 1, 1, 0, 2, 1},
+        {0, 0, 3, 2, 5, 1},
+        {0, 0, 0, 1, 1, 2}};
+    LinearAlgebra::BandedMatrix A = LinearAlgebra::BandedMatrix::fromDense(Common::DenseMatrix(dense), 2, 2);
+    EXPECT_DOUBLE_EQ(A.get(0, 2), 1.0);
+    EXPECT_DOUBLE_EQ(A.get(0, 5), 0.0);
+    EXPECT_THROW(A.at(0, 3), std::out_of_range);
+
+    Common::ValueSeries x_true = {1, -1, 2, 0.5, -2, 3};
+    Common::ValueSeries b = A.multiply(x_true);
+    LinearAlgebra::BandedLUFactorization lu(A);
+    Common::ValueSeries x = lu.solve(b);
+    for (size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(x[i], x_true[i], 1e-12);
+
+    LinearAlgebra::BandedMatrix singular(3, 1, 1);
+    EXPECT_FALSE(LinearAlgebra::BandedLUFactorization().factor(singular));
+}
+
+TEST(BandedTest, LargePentadiagonalProfileAndBatchedSolve) {
+    const size_t n = 100000;
+    LinearAlgebra::BandedMatrix A(n, 2, 2);
+    for (size_t i = 0; i < n; ++i) {
+        A.at(i, i) = 6.0;
+        if (i >= 1) A.at(i, i - 1) = -1.5;
+        if (i >= 2) A.at(i, i - 2) = 0.5;
+        if (i + 1 < n) A.at(i, i + 1) = -2.0;
+        if (i + 2 < n) A.at(i, i + 2) = 1.0;
+    }
+    Common::ValueSeries x_true(n);
+    for (size_t i = 0; i < n; ++i) x_true[i] = std::sin(1e-3 * i);
+    Common::ValueSeries b = A.multiply(x_true);
+
+    std::vector<LinearAlgebra::BandedMatrix> systems(3, A);
+    std::vector<Common::ValueSeries> rhs(3, b);
+    LinearAlgebra::solveBandedBatched(systems, rhs, 2);
+    for (const auto& x : rhs) {
+        for (size_t i = 0; i < n; i += 997) ASSERT_NEAR(x[i], x_true[i], 1e-10);
+    }
+}
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "batched.hpp"
+#include "linalg.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace MeteoNumerical;
+
+namespace {
+    // Układ s: A(i, j) = sin(...) + n na przekątnej, przechowywany z dopełnieniem wierszy a_stride
+    void makeBatch(size_t n, size_t batch, size_t a_stride, size_t b_stride,
+                   std::vector<double>& A, std::vector<double>& b) {
+        A.assign(batch * a_stride, -7.0);
+        b.assign(batch * b_stride, -7.0);
+        for (size_t s = 0; s < batch; ++s) {
+            for (size_t i = 0; i < n; ++i) {
+                b[s * b_stride + i] = std::cos(0.1 * s + i);
+                for (size_t j = 0; j < n; ++j) {
+                    A[s * a_stride + i * n + j] = std::sin(0.3 * s + 1.1 * i + 0.7 * j + 0.2 * i * j) + (i == j ? 0.5 : 0.0);
+                }
+            }
+        }
+    }
+
+    Common::ValueSeries referenceSolve(size_t n, const double* A, const double* b) {
+        Common::Matrix M(n, Common::ValueSeries(n));
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j) M[i][j] = A[i * n + j];
+        return LinearAlgebra::solveWithLU(M, Common::ValueSeries(b, b + n));
+    }
+}
+
+TEST(BatchedSolveTest, MatchesLUForFixedAndGenericSizes) {
+    const size_t batch = 37; // niepodzielne przez szerokość porcji
+    for (size_t n : {1u, 3u, 4u, 7u, 10u, 12u}) {
+        const size_t a_stride = n * n + 3, b_stride = n + 1, x_stride = n + 2;
+        std::vector<double> A, b;
+        makeBatch(n, batch, a_stride, b_stride, A, b);
+        std::vector<double> x(batch * x_stride, -7.0);
+
+        size_t singular = LinearAlgebra::solveSmallSystemsBatched(n, batch, A.data(), a_stride, b.data(), b_stride,
+                                                                  x.data(), x_stride);
+        EXPECT_EQ(singular, 0u);
+        for (size_t s = 0; s < batch; ++s) {
+            Common::ValueSeries expected = referenceSolve(n, A.data() + s * a_stride, b.data() + s * b_stride);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_NEAR(x[s * x_stride + i], expected[i], 1e-9 * (1.0 + std::abs(expected[i]))) << "n=" << n;
+            }
+            for (size_t i = n; i < x_stride; ++i) ASSERT_EQ(x[s * x_stride + i], -7.0); // dopełnienie nietknięte
+        }
+    }
+}
+
+TEST(BatchedSolveTest, SolvesInPlaceWithThreadsAndPivoting) {
+    const size_t n = 5, batch = 1000;
+    std::vector<double> A, b;
+    makeBatch(n, batch, n * n, n, A, b);
+    for (size_t s = 0; s < batch; s += 3) A[s * n * n] = 0.0; // wymaga zamiany wierszy
+
+    std::vector<double> x_serial(batch * n);
+    LinearAlgebra::solveSmallSystemsBatched(n, batch, A.data(), n * n, b.data(), n, x_serial.data(), n, nullptr, 1);
+    std::vector<double> x = b; // rozwiązanie nadpisuje prawe strony
+    LinearAlgebra::solveSmallSystemsBatched(n, batch, A.data(), n * n, x.data(), n, x.data(), n, nullptr, 4);
+
+    for (size_t s = 0; s < batch; ++s) {
+        Common::ValueSeries expected = referenceSolve(n, A.data() + s * n * n, b.data() + s * n);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(x[s * n + i], x_serial[s * n + i]);
+            ASSERT_NEAR(x[s * n + i], expected[i], 1e-9 * (1.0 + std::abs(expected[i])));
+        }
+    }
+}
+
+TEST(BatchedSolveTest, FlagsSingularSystems) {
+    const size_t n = 4, batch = 20;
+    std::vector<double> A, b;
+    makeBatch(n, batch, n * n, n, A, b);
+    for (size_t j = 0; j < n; ++j) {
+        A[3 * n * n + 2 * n + j] = A[3 * n * n + j]; // dwa równe wiersze
+        A[17 * n * n + j * n + 1] = 0.0;             // zerowa kolumna
+    }
+    std::vector<double> x(batch * n);
+    std::vector<unsigned char> flags(batch, 9);
+    size_t singular = LinearAlgebra::solveSmallSystemsBatched(n, batch, A.data(), n * n, b.data(), n,
+                                                              x.data(), n, flags.data());
+    EXPECT_EQ(singular, 2u);
+    for (size_t s = 0; s < batch; ++s) {
+        const bool expected_singular = (s == 3 || s == 17);
+        EXPECT_EQ(flags[s], expected_singular ? 1 : 0);
+        EXPECT_EQ(std::isnan(x[s * n]), expected_singular);
+    }
+
+    EXPECT_THROW(LinearAlgebra::solveSmallSystemsBatched(n, batch, A.data(), n, b.data(), n, x.data(), n),
+                 std::runtime_error);
+}
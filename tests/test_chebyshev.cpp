@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "chebyshev.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeteoNumerical;
+
+namespace {
+    double runge(double x) { return 1.0 / (1.0 + 25.0 * x * x); }
+
+    // Bezpośrednia DCT-I w O(n^2) jako wzorzec dla wersji przez FFT
+    Common::ValueSeries directCoefficients(const Common::ValueSeries& values) {
+        const size_t N = values.size() - 1;
+        const double pi = std::acos(-1.0);
+        Common::ValueSeries c(N + 1, 0.0);
+        for (size_t k = 0; k <= N; ++k) {
+            for (size_t j = 0; j <= N; ++j) {
+                double w = (j == 0 || j == N) ? 0.5 : 1.0;
+                c[k] += w * values[N - j] * std::cos(pi * j * k / N);
+            }
+            c[k] *= 2.0 / N;
+        }
+        c[0] *= 0.5;
+        c[N] *= 0.5;
+        return c;
+    }
+}
+
+TEST(ChebyshevSeriesTest, FFTCoefficientsMatchDirectTransform) {
+    for (size_t n : {2u, 3u, 9u, 12u, 17u, 30u}) {
+        Common::ValueSeries x = Approximation::ChebyshevSeries::points(-2.0, 3.0, n), y;
+        for (double xi : x) y.push_back(std::exp(0.3 * xi) * std::cos(xi));
+        Approximation::ChebyshevSeries s = Approximation::ChebyshevSeries::fromValues(-2.0, 3.0, y);
+        Common::ValueSeries expected = directCoefficients(y);
+        ASSERT_EQ(s.coefficients().size(), n);
+        for (size_t k = 0; k < n; ++k) EXPECT_NEAR(s.coefficients()[k], expected[k], 1e-13) << "n=" << n;
+        for (size_t i = 0; i < n; ++i) EXPECT_NEAR(s(x[i]), y[i], 1e-13);
+    }
+}
+
+TEST(ChebyshevSeriesTest, AdaptiveResolvesSmoothFunctionsToMachinePrecision) {
+    bool converged = false;
+    Approximation::ChebyshevSeries e = Approximation::ChebyshevSeries::adaptive(
+        [](double x) { return std::exp(x); }, -1.0, 1.0, 1e-15, 65537, &converged);
+    EXPECT_TRUE(converged);
+    EXPECT_LE(e.degree(), 20u);
+    for (double x = -1.0; x <= 1.0; x += 0.01) EXPECT_NEAR(e(x), std::exp(x), 1e-14);
+
+    Approximation::ChebyshevSeries r = Approximation::ChebyshevSeries::adaptive(runge, -1.0, 1.0, 1e-14, 65537, &converged);
+    EXPECT_TRUE(converged);
+    EXPECT_GT(r.degree(), 100u);
+    EXPECT_LT(r.degree(), 400u);
+    for (double x = -1.0; x <= 1.0; x += 0.0037) EXPECT_NEAR(r(x), runge(x), 1e-13);
+
+    Approximation::ChebyshevSeries limited = Approximation::ChebyshevSeries::adaptive(
+        [](double x) { return std::abs(x); }, -1.0, 1.0, 1e-15, 129, &converged);
+    EXPECT_FALSE(converged);
+    EXPECT_LE(limited.degree(), 128u);
+}
+
+TEST(ChebyshevSeriesTest, BatchEvaluationMatchesClenshaw) {
+    Approximation::ChebyshevSeries s = Approximation::ChebyshevSeries::interpolate(
+        [](double x) { return std::sin(3.0 * x) + 0.1 * x * x; }, 0.0, 10.0, 77);
+    Common::ValueSeries x;
+    for (int i = 0; i < 203; ++i) x.push_back(10.0 * std::fmod(i * 0.618034, 1.0));
+    Common::ValueSeries values = s.evaluate(x);
+    for (size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(values[i], s(x[i]), 1e-13);
+}
+
+TEST(ChebyshevSeriesTest, DerivativeAndIntegral) {
+    Approximation::ChebyshevSeries s = Approximation::ChebyshevSeries::adaptive(
+        [](double x) { return std::sin(x); }, 0.0, 3.0);
+    Approximation::ChebyshevSeries ds = s.derivative();
+    for (double x = 0.0; x <= 3.0; x += 0.05) EXPECT_NEAR(ds(x), std::cos(x), 1e-12);
+    EXPECT_NEAR(s.definiteIntegral(), 1.0 - std::cos(3.0), 1e-14);
+
+    // T_0 + 2 T_1 + 3 T_2 = 6x^2 + 2x - 2 na [-1, 1]
+    Approximation::ChebyshevSeries p(-1.0, 1.0, {1.0, 2.0, 3.0});
+    EXPECT_NEAR(p(0.5), 0.5, 1e-15);
+    EXPECT_NEAR(p.derivative()(0.5), 8.0, 1e-14);
+    EXPECT_NEAR(p.definiteIntegral(), 0.0, 1e-15);
+}
+
+TEST(ChebyshevSeriesTest, TruncateDropsNegligibleTail) {
+    Approximation::ChebyshevSeries s(0.0, 1.0, {1.0, 0.5, 1e-3, 1e-17, 0.0});
+    s.truncate(1e-12);
+    EXPECT_EQ(s.coefficients().size(), 3u);
+    Approximation::ChebyshevSeries zero(0.0, 1.0, {0.0, 0.0});
+    zero.truncate(1e-12);
+    EXPECT_EQ(zero.degree(), 0u);
+}
+
+TEST(ChebyshevSeriesTest, ThrowsOnInvalidInput) {
+    EXPECT_THROW(Approximation::ChebyshevSeries(1.0, 1.0, {1.0}), std::runtime_error);
+    EXPECT_THROW(Approximation::ChebyshevSeries(0.0, 1.0, {}), std::runtime_error);
+    EXPECT_THROW(Approximation::ChebyshevSeries::fromValues(0.0, 1.0, {}), std::runtime_error);
+    EXPECT_THROW(Approximation::ChebyshevSeries::adaptive([](double x) { return std::sqrt(x); }, -1.0, 1.0),
+                 std::runtime_error);
+    Approximation::ChebyshevSeries empty;
+    EXPECT_THROW(empty(0.5), std::runtime_error);
+}
@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+#include "eigen.hpp"
+#include "linalg.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace MeteoNumerical;
+
+namespace {
+    // Symetryczna macierz z deterministycznymi elementami
+    Common::DenseMatrix makeSymmetric(size_t n, double seed) {
+        Common::DenseMatrix A(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                double v = std::sin(seed + 0.37 * i + 0.91 * j + 0.05 * i * j);
+                A(i, j) = v;
+                A(j, i) = v;
+            }
+        }
+        return A;
+    }
+
+    // max_j ||A v_j - lambda_j v_j||
+    double maxResidual(Common::ConstMatrixView A, const Common::ValueSeries& lambda, const Common::DenseMatrix& V) {
+        const size_t n = A.rows();
+        double worst = 0.0;
+        for (size_t c = 0; c < lambda.size(); ++c) {
+            double norm = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double r = -lambda[c] * V(i, c);
+                for (size_t j = 0; j < n; ++j) r += A(i, j) * V(j, c);
+                norm += r * r;
+            }
+            worst = std::max(worst, std::sqrt(norm));
+        }
+        return worst;
+    }
+
+    double maxOrthogonalityError(const Common::DenseMatrix& V) {
+        double worst = 0.0;
+        for (size_t a = 0; a < V.cols(); ++a) {
+            for (size_t b = 0; b < V.cols(); ++b) {
+                double dot = 0.0;
+                for (size_t i = 0; i < V.rows(); ++i) dot += V(i, a) * V(i, b);
+                worst = std::max(worst, std::abs(dot - (a == b ? 1.0 : 0.0)));
+            }
+        }
+        return worst;
+    }
+}
+
+TEST(SymmetricEigenTest, SmallMatrixKnownSpectrum) {
+    Common::Matrix A = {{2.0, 1.0, 0.0}, {1.0, 2.0, 1.0}, {0.0, 1.0, 2.0}};
+    LinearAlgebra::SymmetricEigenResult r = LinearAlgebra::symmetricEigen(A);
+    ASSERT_EQ(r.eigenvalues.size(), 3u);
+    EXPECT_NEAR(r.eigenvalues[0], 2.0 - std::sqrt(2.0), 1e-13);
+    EXPECT_NEAR(r.eigenvalues[1], 2.0, 1e-13);
+    EXPECT_NEAR(r.eigenvalues[2], 2.0 + std::sqrt(2.0), 1e-13);
+    Common::DenseMatrix dense(A);
+    EXPECT_LT(maxResidual(dense.view(), r.eigenvalues, r.eigenvectors), 1e-13);
+}
+
+TEST(SymmetricEigenTest, DecompositionReconstructsMatrix) {
+    const size_t n = 120;
+    Common::DenseMatrix A = makeSymmetric(n, 0.3);
+    LinearAlgebra::SymmetricEigenResult r = LinearAlgebra::symmetricEigen(A.view());
+    for (size_t j = 1; j < n; ++j) EXPECT_LE(r.eigenvalues[j - 1], r.eigenvalues[j]);
+    EXPECT_LT(maxOrthogonalityError(r.eigenvectors), 1e-12);
+    EXPECT_LT(maxResidual(A.view(), r.eigenvalues, r.eigenvectors), 1e-11);
+
+    LinearAlgebra::SymmetricEigenOptions values_only;
+    values_only.compute_vectors = false;
+    LinearAlgebra::SymmetricEigenResult v = LinearAlgebra::symmetricEigen(A.view(), values_only);
+    EXPECT_TRUE(v.eigenvectors.empty());
+    for (size_t j = 0; j < n; ++j) EXPECT_NEAR(v.eigenvalues[j], r.eigenvalues[j], 1e-11);
+}
+
+TEST(SymmetricEigenTest, ReadsOnlyLowerTriangle) {
+    const size_t n = 15;
+    Common::DenseMatrix A = makeSymmetric(n, 1.1);
+    Common::DenseMatrix lower = A;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j) lower(i, j) = 1e6;
+    LinearAlgebra::SymmetricEigenResult a = LinearAlgebra::symmetricEigen(A.view());
+    LinearAlgebra::SymmetricEigenResult b = LinearAlgebra::symmetricEigen(lower.view());
+    for (size_t j = 0; j < n; ++j) EXPECT_NEAR(a.eigenvalues[j], b.eigenvalues[j], 1e-12);
+}
+
+TEST(SymmetricEigenTest, TridiagonalMatchesClosedForm) {
+    // Macierz (2, -1): lambda_j = 2 - 2 cos(j pi / (n + 1))
+    const size_t n = 50;
+    Common::ValueSeries d(n, 2.0), e(n - 1, -1.0);
+    LinearAlgebra::SymmetricEigenResult r = LinearAlgebra::tridiagonalEigen(d, e);
+    const double pi = std::acos(-1.0);
+    for (size_t j = 0; j < n; ++j) {
+        EXPECT_NEAR(r.eigenvalues[j], 2.0 - 2.0 * std::cos((j + 1) * pi / (n + 1)), 1e-13);
+    }
+    EXPECT_LT(maxOrthogonalityError(r.eigenvectors), 1e-13);
+    EXPECT_THROW(LinearAlgebra::tridiagonalEigen(d, Common::ValueSeries(n, 1.0)), std::runtime_error);
+}
+
+TEST(SymmetricEigenTest, ThrowsOnInvalidInput) {
+    Common::DenseMatrix rect(3, 4);
+    EXPECT_THROW(LinearAlgebra::symmetricEigen(rect.view()), std::runtime_error);
+    Common::DenseMatrix bad(2, 2, 1.0);
+    bad(1, 0) = NAN;
+    EXPECT_THROW(LinearAlgebra::symmetricEigen(bad.view()), std::runtime_error);
+}
+
+TEST(LanczosTest, TopEigenpairsMatchFullDecomposition) {
+    const size_t n = 300, k = 5;
+    // Kowariancja-podobna macierz: B^T B ma dodatnie widmo z wyraźnymi największymi wartościami
+    Common::DenseMatrix B = makeSymmetric(n, 0.7);
+    Common::DenseMatrix A(n, n);
+    LinearAlgebra::gemm(LinearAlgebra::Transpose::Yes, LinearAlgebra::Transpose::No, 1.0, B.view(), B.view(), 0.0, A.view());
+
+    LinearAlgebra::LanczosResult top = LinearAlgebra::lanczosTopK(A.view(), k);
+    LinearAlgebra::SymmetricEigenResult full = LinearAlgebra::symmetricEigen(A.view());
+    ASSERT_TRUE(top.converged);
+    ASSERT_EQ(top.eigenvalues.size(), k);
+    for (size_t i = 0; i < k; ++i) {
+        EXPECT_NEAR(top.eigenvalues[i], full.eigenvalues[n - 1 - i], 1e-8 * full.eigenvalues[n - 1]);
+    }
+    EXPECT_LT(maxResidual(A.view(), top.eigenvalues, top.eigenvectors), 1e-7 * full.eigenvalues[n - 1]);
+    EXPECT_LT(maxOrthogonalityError(top.eigenvectors), 1e-10);
+    EXPECT_LT(top.matvecs, n);
+}
+
+TEST(LanczosTest, HandlesLowRankOperator) {
+    // Operator rzędu 2 podany jako funkcja: x -> u (u.x) * 3 + w (w.x)
+    const size_t n = 200;
+    Common::ValueSeries u(n), w(n);
+    double nu = 0.0, nw = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        u[i] = 1.0;
+        w[i] = (i % 2 == 0) ? 1.0 : -1.0;
+        nu += u[i] * u[i];
+        nw += w[i] * w[i];
+    }
+    LinearAlgebra::SymmetricOperator apply = [&](const double* x, double* y) {
+        double du = 0.0, dw = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            du += u[i] * x[i];
+            dw += w[i] * x[i];
+        }
+        for (size_t i = 0; i < n; ++i) y[i] = 3.0 * u[i] * du / nu + w[i] * dw / nw;
+    };
+    LinearAlgebra::LanczosResult r = LinearAlgebra::lanczosTopK(n, apply, 3);
+    ASSERT_TRUE(r.converged);
+    EXPECT_NEAR(r.eigenvalues[0], 3.0, 1e-10);
+    EXPECT_NEAR(r.eigenvalues[1], 1.0, 1e-10);
+    EXPECT_NEAR(r.eigenvalues[2], 0.0, 1e-10);
+}
+
+TEST(LanczosTest, ThrowsOnInvalidArguments) {
+    Common::DenseMatrix A = makeSymmetric(4, 0.0);
+    EXPECT_THROW(LinearAlgebra::lanczosTopK(A.view(), 0), std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::lanczosTopK(A.view(), 5), std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::lanczosTopK(4, LinearAlgebra::SymmetricOperator(), 1), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "integration.hpp"
 #include <cmath>
+#include <thread>
+#include <vector>
 
 // Funkcja do testowania: f(x) = x^2
 // Całka od 0 do 3 z x^2 dx = [x^3 / 3] od 0 do 3 = 27/3 = 9
@@ -36,5 +38,138 @@ TEST(IntegrationTest, GaussLegendreQuadrature) {
 }
 
 TEST(IntegrationTest, GaussLegendreThrowsOnInvalidPointCount) {
-    EXPECT_THROW(MeteoNumerical::Integration::GaussLegendre::quadrature(square, 0.0, 3.0, 7), std::out_of_range);
-}
\ No newline at end of file
+    EXPECT_THROW(MeteoNumerical::Integration::GaussLegendre::quadrature(square, 0.0, 3.0, 0), std::out_of_range);
+}
+
+TEST(IntegrationTest, CallableOverloadsMatchStdFunction) {
+    // Lambda i funktor trafiają do wersji szablonowych, std::function do nakładek - wyniki są identyczne.
+    struct Cube {
+        double operator()(double x) const { return x * x * x; }
+    };
+    auto lambda = [](double x) { return std::exp(-x) * x; };
+    MeteoNumerical::Integration::IntegrableFunction wrapped = lambda;
+    namespace I = MeteoNumerical::Integration;
+    EXPECT_EQ(I::rectangleRule(lambda, 0.0, 2.0, 101), I::rectangleRule(wrapped, 0.0, 2.0, 101));
+    EXPECT_EQ(I::trapezoidalRule(lambda, 0.0, 2.0, 101), I::trapezoidalRule(wrapped, 0.0, 2.0, 101));
+    EXPECT_EQ(I::simpsonRule(lambda, 0.0, 2.0, 101), I::simpsonRule(wrapped, 0.0, 2.0, 101));
+    EXPECT_EQ(I::GaussLegendre::composite(lambda, 0.0, 2.0, 5, 7), I::GaussLegendre::composite(wrapped, 0.0, 2.0, 5, 7));
+    EXPECT_NEAR(I::GaussLegendre::quadrature(Cube(), 0.0, 2.0, 3), 4.0, 1e-14);
+    EXPECT_NEAR(I::simpsonRule(Cube(), 0.0, 2.0, 10), 4.0, 1e-13);
+    EXPECT_NEAR(I::GaussLegendre::composite(lambda, 0.0, 2.0, 6, 4), 1.0 - 3.0 * std::exp(-2.0), 1e-12);
+}
+
+TEST(GaussKronrodTest, RulesAreExactForPolynomialsOfDesignDegree) {
+    // Kronrod 2n+1 punktów: stopień 3n+1 (n parzyste) / 3n+2 (n nieparzyste); Gauss n punktów: 2n-1.
+    namespace GK = MeteoNumerical::Integration::GaussKronrod;
+    struct Case { GK::Rule rule; int kronrod_degree; int gauss_degree; };
+    for (Case c : {Case{GK::Rule::G7K15, 23, 13}, Case{GK::Rule::G10K21, 31, 19}}) {
+        GK::Nodes r = GK::nodes(c.rule);
+        for (int degree = 0; degree <= c.kronrod_degree + 1; ++degree) {
+            double exact = (degree % 2 == 0) ? 2.0 / (degree + 1) : 0.0;
+            double kronrod = r.wgk[r.kronrod_half - 1] * (degree == 0 ? 1.0 : 0.0);
+            double gauss = r.gauss_center ? r.wg[r.gauss_half - 1] * (degree == 0 ? 1.0 : 0.0) : 0.0;
+            for (int j = 0; j + 1 < r.kronrod_half; ++j) {
+                double v = std::pow(r.xgk[j], degree) + std::pow(-r.xgk[j], degree);
+                kronrod += r.wgk[j] * v;
+                if (j % 2 == 1) gauss += r.wg[j / 2] * v;
+            }
+            if (degree <= c.kronrod_degree) {
+                EXPECT_NEAR(kronrod, exact, 1e-15) << "degree " << degree;
+            } else {
+                EXPECT_GT(std::abs(kronrod - exact), 1e-12);
+            }
+            if (degree <= c.gauss_degree) {
+                EXPECT_NEAR(gauss, exact, 1e-15) << "degree " << degree;
+            } else if (degree == c.gauss_degree + 1) {
+                EXPECT_GT(std::abs(gauss - exact), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GaussKronrodTest, AdaptiveResolvesPeakWithFewEvaluations) {
+    namespace GK = MeteoNumerical::Integration::GaussKronrod;
+    long calls = 0;
+    auto peak = [&calls](double x) { ++calls; return 1.0 / ((x - 0.3) * (x - 0.3) + 1e-6); };
+    const double exact = 1e3 * (std::atan(700.0) + std::atan(300.0));
+    GK::Options opts;
+    opts.abs_tolerance = 0.0;
+    opts.rel_tolerance = 1e-12;
+    for (GK::Rule rule : {GK::Rule::G7K15, GK::Rule::G10K21}) {
+        calls = 0;
+        opts.rule = rule;
+        GK::Result r = GK::integrate(peak, 0.0, 1.0, opts);
+        EXPECT_TRUE(r.converged);
+        EXPECT_NEAR(r.value, exact, 1e-10 * exact);
+        EXPECT_LE(std::abs(r.value - exact), r.error_estimate + 1e-12 * exact);
+        EXPECT_EQ(r.evaluations, static_cast<size_t>(calls));
+        EXPECT_LT(r.evaluations, 3000u);
+    }
+    // Simpson na równych podprzedziałach przy tej samej liczbie próbek jest o rzędy wielkości gorszy
+    double simpson = MeteoNumerical::Integration::simpsonRule(peak, 0.0, 1.0, 3000);
+    EXPECT_GT(std::abs(simpson - exact), 1e-6 * exact);
+}
+
+TEST(GaussKronrodTest, ReversedLimitsLimitsAndErrors) {
+    namespace GK = MeteoNumerical::Integration::GaussKronrod;
+    MeteoNumerical::Integration::IntegrableFunction f = [](double x) { return std::sqrt(x); };
+    GK::Result forward = GK::integrate(f, 0.0, 4.0);
+    EXPECT_TRUE(forward.converged);
+    EXPECT_NEAR(forward.value, 16.0 / 3.0, 1e-9);
+    GK::Result backward = GK::integrate(f, 4.0, 0.0);
+    EXPECT_DOUBLE_EQ(backward.value, -forward.value);
+    EXPECT_EQ(GK::integrate(f, 1.0, 1.0).value, 0.0);
+
+    GK::Options tight;
+    tight.abs_tolerance = 0.0;
+    tight.rel_tolerance = 1e-15;
+    tight.max_intervals = 3;
+    GK::Result limited = GK::integrate([](double x) { return std::abs(x - 0.1234); }, -1.0, 1.0, tight);
+    EXPECT_FALSE(limited.converged);
+    EXPECT_LE(limited.intervals, 3u);
+    EXPECT_EQ(limited.evaluations, 15u * (2 * limited.intervals - 1));
+
+    GK::Options bad;
+    bad.abs_tolerance = 0.0;
+    bad.rel_tolerance = 0.0;
+    EXPECT_THROW(GK::integrate(f, 0.0, 1.0, bad), std::runtime_error);
+    EXPECT_THROW(GK::integrate(f, 0.0, INFINITY), std::runtime_error);
+}
+
+TEST(GaussLegendreTest, ArbitraryOrderRulesAreExact) {
+    namespace GL = MeteoNumerical::Integration::GaussLegendre;
+    for (int n : {1, 2, 5, 10, 11, 17, 40, 100, 257}) {
+        GL::Rule r = GL::rule(n);
+        ASSERT_EQ(r.size, n);
+        double weight_sum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            weight_sum += r.weights[i];
+            EXPECT_NEAR(r.nodes[i], -r.nodes[n - 1 - i], 1e-15);
+            if (i > 0) {
+                EXPECT_LT(r.nodes[i - 1], r.nodes[i]);
+            }
+        }
+        EXPECT_NEAR(weight_sum, 2.0, 1e-13);
+        // x^(2n-2) jest całkowane dokładnie (x^(2n-1) trywialnie przez symetrię)
+        const int degree = 2 * n - 2;
+        double q = GL::quadrature([degree](double x) { return std::pow(x, degree); }, -1.0, 1.0, n);
+        EXPECT_NEAR(q, 2.0 / (degree + 1), 1e-14) << "n = " << n;
+    }
+    // Reguła wysokiego rzędu na jednym przedziale zamiast wielu przedziałów niskiego rzędu
+    EXPECT_NEAR(GL::quadrature([](double x) { return std::exp(x) * std::cos(3.0 * x); }, 0.0, 2.0, 20),
+                (std::exp(2.0) * (std::cos(6.0) + 3.0 * std::sin(6.0)) - 1.0) / 10.0, 1e-14);
+}
+
+TEST(GaussLegendreTest, CachedRulesAreSharedBetweenThreads) {
+    namespace GL = MeteoNumerical::Integration::GaussLegendre;
+    std::vector<const double*> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&seen, t]() { seen[t] = GL::rule(t % 2 == 0 ? 333 : 2048).nodes; });
+    }
+    for (auto& th : threads) th.join();
+    for (size_t t = 2; t < seen.size(); ++t) EXPECT_EQ(seen[t], seen[t % 2]);
+    EXPECT_EQ(GL::rule(333).nodes, seen[0]);
+    EXPECT_NE(seen[0], seen[1]);
+    EXPECT_THROW(GL::rule(-3), std::out_of_range);
+}
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "interpolation.hpp"
 #include <stdexcept>
+#include <cmath>
+#include <vector>
 
 // TEST POPRAWNY: Interpolacja w węźle powinna zwrócić wartość z tego węzła
 TEST(InterpolationTest, LagrangeReturnsNodeValueAtNode) {
@@ -114,4 +116,265 @@ TEST(HelperFunctionTest, SelectNodesByStep) {
     k = 0;
     // Test 4: Sprawdzenie rzucania wyjątku dla k=0
     EXPECT_THROW(MeteoNumerical::Interpolation::selectNodesByStep(x_all, y_all, x_nodes, y_nodes, 0), std::runtime_error);
-}
\ No newline at end of file
+}
+
+// --- Interpolacja barycentryczna ---
+
+namespace {
+    double runge(double x) { return 1.0 / (1.0 + 25.0 * x * x); }
+}
+
+TEST(BarycentricInterpolatorTest, MatchesLagrangeForArbitraryNodes) {
+    MeteoNumerical::Common::ValueSeries x = {-1.0, -0.3, 0.1, 0.45, 1.2, 2.0};
+    MeteoNumerical::Common::ValueSeries y = {2.0, -1.0, 0.5, 3.0, 1.0, -2.0};
+    MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator p(x, y);
+    MeteoNumerical::Common::ValueSeries points;
+    for (int i = 0; i <= 37; ++i) points.push_back(-1.5 + 0.1 * i);
+    MeteoNumerical::Common::ValueSeries batch = p.evaluate(points);
+    ASSERT_EQ(batch.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        double expected = MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolate(x, y, points[i]);
+        EXPECT_NEAR(p(points[i]), expected, 1e-10);
+        EXPECT_NEAR(batch[i], expected, 1e-10);
+    }
+}
+
+TEST(BarycentricInterpolatorTest, BatchReturnsExactNodeValues) {
+    MeteoNumerical::Common::ValueSeries x = {0.0, 1.0, 2.0, 3.0};
+    MeteoNumerical::Common::ValueSeries y = {1.0, 3.0, 0.0, 2.0};
+    MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator p(x, y);
+    MeteoNumerical::Common::ValueSeries points = {2.0, 0.5, 1.0, 3.0, 0.0, 2.5, 2.0, 1.0, 3.0};
+    MeteoNumerical::Common::ValueSeries out = p.evaluate(points);
+    EXPECT_EQ(out[0], 0.0);
+    EXPECT_EQ(out[2], 3.0);
+    EXPECT_EQ(out[3], 2.0);
+    EXPECT_EQ(out[4], 1.0);
+    EXPECT_EQ(out[8], 2.0);
+    EXPECT_NEAR(out[1], MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolate(x, y, 0.5), 1e-12);
+
+    // Nowe dane na tych samych węzłach bez przeliczania wag
+    p.setValues({5.0, 5.0, 5.0, 5.0});
+    EXPECT_NEAR(p(1.7), 5.0, 1e-12);
+}
+
+TEST(BarycentricInterpolatorTest, ChebyshevNodesConvergeForRungeFunction) {
+    using MeteoNumerical::Interpolation::Lagrange::ChebyshevKind;
+    for (ChebyshevKind kind : {ChebyshevKind::FirstKind, ChebyshevKind::SecondKind}) {
+        MeteoNumerical::Common::ValueSeries nodes = MeteoNumerical::Interpolation::Lagrange::chebyshevNodes(-1.0, 1.0, 121, kind);
+        MeteoNumerical::Common::ValueSeries y;
+        for (double xi : nodes) y.push_back(runge(xi));
+        auto p = MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator::chebyshev(-1.0, 1.0, y, kind);
+        EXPECT_EQ(p.nodes(), nodes);
+        double max_error = 0.0;
+        for (int i = 0; i <= 1000; ++i) {
+            double xp = -1.0 + 0.002 * i;
+            max_error = std::max(max_error, std::abs(p(xp) - runge(xp)));
+        }
+        EXPECT_LT(max_error, 1e-8);
+    }
+}
+
+TEST(BarycentricInterpolatorTest, EquispacedClosedFormMatchesGeneralWeights) {
+    const size_t n = 15;
+    MeteoNumerical::Common::ValueSeries x(n), y(n);
+    for (size_t j = 0; j < n; ++j) {
+        x[j] = 2.0 + 3.0 * j / (n - 1.0);
+        y[j] = std::sin(x[j]);
+    }
+    auto closed = MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator::equispaced(2.0, 5.0, y);
+    MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator general(x, y);
+    for (int i = 0; i <= 60; ++i) {
+        double xp = 2.0 + 0.05 * i + 0.001;
+        EXPECT_NEAR(closed(xp), general(xp), 1e-12);
+        EXPECT_NEAR(closed(xp), std::sin(xp), 1e-9);
+    }
+}
+
+TEST(BarycentricInterpolatorTest, ThrowsOnInvalidInput) {
+    using MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator;
+    EXPECT_THROW(BarycentricInterpolator({0.0, 1.0, 1.0}, {1.0, 2.0, 3.0}), std::runtime_error);
+    EXPECT_THROW(BarycentricInterpolator({0.0, 1.0}, {1.0}), std::runtime_error);
+    EXPECT_THROW(BarycentricInterpolator::equispaced(1.0, 1.0, {1.0, 2.0}), std::runtime_error);
+    BarycentricInterpolator empty;
+    EXPECT_THROW(empty(0.5), std::runtime_error);
+    BarycentricInterpolator p({0.0, 1.0}, {1.0, 2.0});
+    EXPECT_THROW(p.setValues({1.0, 2.0, 3.0}), std::runtime_error);
+}
+
+// --- Współczynniki Newtona w pamięci O(n) i interpolant przyrostowy ---
+
+TEST(NewtonCoefficientsTest, InPlaceMatchesDividedDifferenceTable) {
+    MeteoNumerical::Common::ValueSeries x = {0.0, 0.7, 1.3, 2.0, 2.4, 3.9};
+    MeteoNumerical::Common::ValueSeries y = {1.0, -2.0, 0.5, 4.0, 3.0, -1.0};
+    auto table = MeteoNumerical::Interpolation::Newton::calculateDividedDifferences(x, y);
+    auto expected = MeteoNumerical::Interpolation::Newton::getNewtonCoefficients(table);
+    MeteoNumerical::Common::ValueSeries coeffs = MeteoNumerical::Interpolation::Newton::newtonCoefficients(x, y);
+    ASSERT_EQ(coeffs.size(), expected.size());
+    for (size_t i = 0; i < coeffs.size(); ++i) EXPECT_NEAR(coeffs[i], expected[i], 1e-12);
+
+    MeteoNumerical::Common::ValueSeries dup_x = {0.0, 1.0, 1.0};
+    MeteoNumerical::Common::ValueSeries values = {1.0, 2.0, 3.0};
+    EXPECT_THROW(MeteoNumerical::Interpolation::Newton::newtonCoefficientsInPlace(dup_x, values), std::runtime_error);
+}
+
+TEST(NewtonInterpolantTest, IncrementalNodesMatchBatchCoefficients) {
+    MeteoNumerical::Interpolation::Newton::NewtonInterpolant p;
+    MeteoNumerical::Common::ValueSeries x, y;
+    for (int i = 0; i < 12; ++i) {
+        double xi = 0.5 * i + 0.1 * std::sin(i);
+        double yi = std::cos(xi);
+        p.addNode(xi, yi);
+        x.push_back(xi);
+        y.push_back(yi);
+        auto expected = MeteoNumerical::Interpolation::Newton::newtonCoefficients(x, y);
+        ASSERT_EQ(p.coefficients().size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) EXPECT_NEAR(p.coefficients()[k], expected[k], 1e-9);
+    }
+    for (double xp : {0.3, 1.7, 4.2}) {
+        EXPECT_NEAR(p(xp), MeteoNumerical::Interpolation::Newton::newtonInterpolate(x, p.coefficients(), xp), 1e-12);
+        EXPECT_NEAR(p(xp), MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolate(x, y, xp), 1e-9);
+    }
+    for (size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(p(x[i]), y[i], 1e-10);
+}
+
+TEST(NewtonInterpolantTest, ThrowsOnDuplicateOrEmpty) {
+    MeteoNumerical::Interpolation::Newton::NewtonInterpolant p({0.0, 1.0}, {1.0, 2.0});
+    EXPECT_THROW(p.addNode(1.0, 5.0), std::runtime_error);
+    EXPECT_EQ(p.size(), 2u);
+    EXPECT_NEAR(p(0.5), 1.5, 1e-12);
+    p.clear();
+    EXPECT_THROW(p(0.5), std::runtime_error);
+    EXPECT_THROW(p.addNodes({0.0, 1.0}, {1.0}), std::runtime_error);
+}
+
+// --- Wartościowanie wsadowe ---
+
+TEST(BatchEvaluationTest, HornerBatchMatchesScalar) {
+    MeteoNumerical::Common::ValueSeries coeffs = {1.5, -2.0, 0.25, 3.0, -0.5, 0.125};
+    MeteoNumerical::Common::ValueSeries x;
+    for (int i = 0; i < 29; ++i) x.push_back(-2.0 + 0.15 * i);
+    MeteoNumerical::Common::ValueSeries y = MeteoNumerical::Common::evaluatePolynomialHornerBatch(coeffs, x);
+    ASSERT_EQ(y.size(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(y[i], MeteoNumerical::Common::evaluatePolynomialHorner(coeffs, x[i]), 1e-12);
+    }
+    MeteoNumerical::Common::ValueSeries zero = MeteoNumerical::Common::evaluatePolynomialHornerBatch({}, x);
+    EXPECT_EQ(zero[3], 0.0);
+}
+
+TEST(BatchEvaluationTest, NewtonAndLagrangeBatchMatchScalar) {
+    MeteoNumerical::Common::ValueSeries x = {0.0, 0.5, 1.5, 2.0, 3.5, 4.0, 5.0};
+    MeteoNumerical::Common::ValueSeries y;
+    for (double xi : x) y.push_back(std::exp(-0.3 * xi) * std::cos(xi));
+    MeteoNumerical::Common::ValueSeries coeffs = MeteoNumerical::Interpolation::Newton::newtonCoefficients(x, y);
+    MeteoNumerical::Common::ValueSeries points;
+    for (int i = 0; i < 43; ++i) points.push_back(-0.5 + 0.13 * i);
+
+    MeteoNumerical::Common::ValueSeries newton(points.size()), lagrange(points.size());
+    MeteoNumerical::Interpolation::Newton::newtonInterpolateBatch(x, coeffs, points.data(), newton.data(), points.size());
+    MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolateBatch(x, y, points.data(), lagrange.data(), points.size());
+    MeteoNumerical::Interpolation::Newton::NewtonInterpolant interpolant(x, y);
+    MeteoNumerical::Common::ValueSeries incremental = interpolant.evaluate(points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        double expected = MeteoNumerical::Interpolation::Newton::newtonInterpolate(x, coeffs, points[i]);
+        EXPECT_NEAR(newton[i], expected, 1e-10);
+        EXPECT_NEAR(lagrange[i], expected, 1e-10);
+        EXPECT_NEAR(incremental[i], expected, 1e-10);
+    }
+}
+
+TEST(BatchEvaluationTest, BatchMSEMatchesPointwiseMSE) {
+    MeteoNumerical::Common::ValueSeries x_all, y_all;
+    for (int i = 0; i <= 40; ++i) {
+        x_all.push_back(0.1 * i);
+        y_all.push_back(std::sin(0.1 * i));
+    }
+    MeteoNumerical::Common::ValueSeries x_nodes, y_nodes;
+    MeteoNumerical::Interpolation::selectNodesByStep(x_all, y_all, x_nodes, y_nodes, 8);
+
+    MeteoNumerical::Common::ValueSeries pointwise_errors;
+    double pointwise = MeteoNumerical::Interpolation::calculateInterpolationMSE(
+        x_all, y_all, x_nodes, y_nodes, MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolate, &pointwise_errors);
+
+    MeteoNumerical::Interpolation::Lagrange::BarycentricInterpolator p(x_nodes, y_nodes);
+    MeteoNumerical::Common::ValueSeries batch_errors, batch_x;
+    double batch = MeteoNumerical::Interpolation::calculateInterpolationMSE(
+        x_all, y_all,
+        [&](const double* x, double* y, size_t count) { p.evaluate(x, y, count); },
+        &batch_errors, &batch_x);
+    EXPECT_NEAR(batch, pointwise, 1e-14);
+    ASSERT_EQ(batch_errors.size(), pointwise_errors.size());
+    for (size_t i = 0; i < batch_errors.size(); ++i) EXPECT_NEAR(batch_errors[i], pointwise_errors[i], 1e-14);
+    EXPECT_EQ(batch_x, x_all);
+
+    EXPECT_THROW(MeteoNumerical::Interpolation::calculateInterpolationMSE(
+                     x_all, y_all, MeteoNumerical::Interpolation::BatchInterpolatorFunc()),
+                 std::runtime_error);
+}
+
+// --- Przegląd kroków wyboru węzłów ---
+
+TEST(NodeStepSweepTest, MatchesSelectNodesAndPointwiseMSE) {
+    MeteoNumerical::Common::ValueSeries x_all, y_all;
+    for (int i = 0; i <= 40; ++i) {
+        x_all.push_back(0.05 * i);
+        y_all.push_back(std::sin(1.3 * x_all.back()) + 0.2 * x_all.back());
+    }
+    auto table = MeteoNumerical::Interpolation::sweepNodeSteps(x_all, y_all, 1, 9);
+    ASSERT_EQ(table.size(), 9u);
+    for (unsigned k = 1; k <= 9; ++k) {
+        const auto& entry = table[k - 1];
+        EXPECT_EQ(entry.k_step, k);
+        MeteoNumerical::Common::ValueSeries x_nodes, y_nodes;
+        MeteoNumerical::Interpolation::selectNodesByStep(x_all, y_all, x_nodes, y_nodes, k);
+        EXPECT_EQ(entry.node_count, x_nodes.size());
+        double expected = MeteoNumerical::Interpolation::calculateInterpolationMSE(
+            x_all, y_all, x_nodes, y_nodes, MeteoNumerical::Interpolation::Lagrange::lagrangeInterpolate);
+        EXPECT_NEAR(entry.mse, expected, 1e-9 * std::max(1.0, expected));
+        EXPECT_TRUE(entry.squared_errors.empty());
+    }
+}
+
+TEST(NodeStepSweepTest, CustomInterpolatorAndPointErrorsAreThreadIndependent) {
+    MeteoNumerical::Common::ValueSeries x_all, y_all;
+    for (int i = 0; i < 500; ++i) {
+        x_all.push_back(0.02 * i);
+        y_all.push_back(std::cos(x_all.back()));
+    }
+    // Interpolacja liniowa odcinkami na widokach węzłów
+    MeteoNumerical::Interpolation::NodeViewInterpolator linear =
+        [](MeteoNumerical::Common::ConstVectorView xn, MeteoNumerical::Common::ConstVectorView yn,
+           const double* x, double* out, size_t count) {
+            size_t j = 0;
+            for (size_t i = 0; i < count; ++i) {
+                while (j + 2 < xn.size() && x[i] > xn[j + 1]) ++j;
+                double t = xn.size() > 1 ? (x[i] - xn[j]) / (xn[j + 1] - xn[j]) : 0.0;
+                out[i] = xn.size() > 1 ? yn[j] + t * (yn[j + 1] - yn[j]) : yn[0];
+            }
+        };
+    MeteoNumerical::Interpolation::NodeStepSweepOptions serial;
+    serial.keep_point_errors = true;
+    serial.num_threads = 1;
+    MeteoNumerical::Interpolation::NodeStepSweepOptions parallel = serial;
+    parallel.num_threads = 4;
+    auto a = MeteoNumerical::Interpolation::sweepNodeSteps(x_all, y_all, 1, 60, serial, linear);
+    auto b = MeteoNumerical::Interpolation::sweepNodeSteps(x_all, y_all, 1, 60, parallel, linear);
+    ASSERT_EQ(a.size(), 60u);
+    EXPECT_NEAR(a[0].mse, 0.0, 1e-30);
+    for (size_t s = 0; s < a.size(); ++s) {
+        EXPECT_EQ(a[s].mse, b[s].mse);
+        ASSERT_EQ(a[s].squared_errors.size(), x_all.size());
+        EXPECT_EQ(a[s].squared_errors, b[s].squared_errors);
+        double mean = 0.0;
+        for (double e : a[s].squared_errors) mean += e;
+        EXPECT_NEAR(mean / x_all.size(), a[s].mse, 1e-15);
+    }
+    EXPECT_LT(a[4].mse, a[40].mse); // gęstsze węzły - mniejszy błąd
+}
+
+TEST(NodeStepSweepTest, ThrowsOnInvalidRange) {
+    MeteoNumerical::Common::ValueSeries x = {0.0, 1.0, 2.0}, y = {1.0, 2.0, 3.0};
+    EXPECT_THROW(MeteoNumerical::Interpolation::sweepNodeSteps(x, y, 0, 2), std::runtime_error);
+    EXPECT_THROW(MeteoNumerical::Interpolation::sweepNodeSteps(x, y, 3, 2), std::runtime_error);
+    EXPECT_THROW(MeteoNumerical::Interpolation::sweepNodeSteps(x, {1.0}, 1, 2), std::runtime_error);
+}
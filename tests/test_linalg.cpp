@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include "linalg.hpp"
 #include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <sstream>
+#include <string>
 
 using namespace MeteoNumerical;
 
@@ -63,4 +67,591 @@ TEST(LinearAlgebraTest, MatrixMultiplicationThrowsOnDimensionMismatch) {
     MeteoNumerical::Common::Matrix B = {{1}, {2}, {3}};  // 3x1
     
     EXPECT_THROW(MeteoNumerical::LinearAlgebra::multiplyMatrices(A, B), std::runtime_error);
-}
\ No newline at end of file
+}
+
+// --- Testy typu DenseMatrix i widoków ---
+
+TEST(DenseMatrixTest, RoundTripsNestedMatrixAndExposesViews) {
+    Common::Matrix nested = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    Common::DenseMatrix M(nested);
+
+    ASSERT_EQ(M.rows(), 3u);
+    ASSERT_EQ(M.cols(), 3u);
+    EXPECT_EQ(M.toNested(), nested);
+
+    Common::ConstVectorView col = M.column(1);
+    EXPECT_EQ(col.size(), 3u);
+    EXPECT_DOUBLE_EQ(col[2], 8.0);
+
+    Common::MatrixView sub = M.block(1, 1, 2, 2);
+    EXPECT_DOUBLE_EQ(sub(0, 0), 5.0);
+    EXPECT_DOUBLE_EQ(sub(1, 1), 9.0);
+    sub(0, 1) = -6.0; // Widok nie jest właścicielem danych - modyfikuje M
+    EXPECT_DOUBLE_EQ(M(1, 2), -6.0);
+
+    EXPECT_THROW(M.block(2, 2, 2, 2), std::out_of_range);
+    EXPECT_THROW(Common::DenseMatrix(Common::Matrix{{1, 2}, {3}}), std::runtime_error);
+}
+
+TEST(DenseMatrixTest, SolvesSystemStoredWithPaddedLeadingDimension) {
+    // Wiersze dopełnione do 8 elementów; LinearAlgebra musi respektować ld.
+    Common::DenseMatrix A(3, 3, -99.0, 8);
+    double values[3][3] = {{4, 1, -1}, {2, 5, 1}, {1, 1, 3}};
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j) A(i, j) = values[i][j];
+    Common::ValueSeries b = {5, 19, 10};
+
+    Common::ValueSeries x = LinearAlgebra::solveWithLU(A, b);
+    ASSERT_EQ(x.size(), 3u);
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NEAR(x[1], 3.0, 1e-12);
+    EXPECT_NEAR(x[2], 2.0, 1e-12);
+
+    // Podmacierz jako układ 2x2 bez kopiowania
+    Common::ValueSeries x2 = LinearAlgebra::solveWithLU(A.block(1, 1, 2, 2), Common::ValueSeries{6, 4});
+    EXPECT_NEAR(5 * x2[0] + 1 * x2[1], 6.0, 1e-12);
+    EXPECT_NEAR(1 * x2[0] + 3 * x2[1], 4.0, 1e-12);
+}
+
+TEST(DenseMatrixTest, MultiplyMatricesMatchesNestedAdapter) {
+    Common::Matrix A = {{1, 2, 3}, {4, 5, 6}};
+    Common::Matrix B = {{7, 8}, {9, 10}, {11, 12}};
+
+    Common::DenseMatrix C = LinearAlgebra::multiplyMatrices(Common::DenseMatrix(A), Common::DenseMatrix(B));
+    EXPECT_EQ(C.toNested(), LinearAlgebra::multiplyMatrices(A, B));
+    EXPECT_DOUBLE_EQ(C(0, 0), 58.0);
+    EXPECT_DOUBLE_EQ(C(1, 1), 154.0);
+}
+
+
+// --- Testy GEMM ---
+
+namespace {
+Common::DenseMatrix makeTestMatrix(size_t rows, size_t cols, double seed) {
+    Common::DenseMatrix M(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j) M(i, j) = std::sin(seed + 0.37 * i + 1.13 * j + 0.21 * i * j);
+    return M;
+}
+
+// Referencyjne C = alpha * op(A) * op(B) + beta * C
+Common::DenseMatrix naiveGemm(bool tA, bool tB, double alpha, const Common::DenseMatrix& A,
+                              const Common::DenseMatrix& B, double beta, Common::DenseMatrix C) {
+    size_t m = C.rows(), n = C.cols(), k = tA ? A.rows() : A.cols();
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (size_t p = 0; p < k; ++p) sum += (tA ? A(p, i) : A(i, p)) * (tB ? B(j, p) : B(p, j));
+            C(i, j) = alpha * sum + beta * C(i, j);
+        }
+    return C;
+}
+} // namespace
+
+TEST(GemmTest, MatchesNaiveProductForAllKernelsAndTransposes) {
+    const size_t m = 67, n = 53, k = 301; // rozmiary niepodzielne przez bloki i kafelki
+    const LinearAlgebra::GemmKernel kernels[] = {LinearAlgebra::GemmKernel::Scalar,
+                                                 LinearAlgebra::GemmKernel::AVX2,
+                                                 LinearAlgebra::GemmKernel::AVX512};
+    for (auto kernel : kernels) {
+        if (!LinearAlgebra::isGemmKernelSupported(kernel)) continue;
+        LinearAlgebra::setGemmKernel(kernel);
+        for (int variant = 0; variant < 4; ++variant) {
+            bool tA = variant & 1, tB = variant & 2;
+            Common::DenseMatrix A = tA ? makeTestMatrix(k, m, 0.1) : makeTestMatrix(m, k, 0.1);
+            Common::DenseMatrix B = tB ? makeTestMatrix(n, k, 0.7) : makeTestMatrix(k, n, 0.7);
+            Common::DenseMatrix C = makeTestMatrix(m, n, 2.0);
+            Common::DenseMatrix expected = naiveGemm(tA, tB, -1.5, A, B, 0.5, C);
+
+            LinearAlgebra::gemm(tA ? LinearAlgebra::Transpose::Yes : LinearAlgebra::Transpose::No,
+                                tB ? LinearAlgebra::Transpose::Yes : LinearAlgebra::Transpose::No,
+                                -1.5, A, B, 0.5, C);
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < n; ++j) ASSERT_NEAR(C(i, j), expected(i, j), 1e-11);
+        }
+    }
+    LinearAlgebra::setGemmKernel(LinearAlgebra::GemmKernel::Auto);
+}
+
+TEST(GemmTest, BetaZeroIgnoresGarbageAndRespectsSubmatrixViews) {
+    Common::DenseMatrix A = makeTestMatrix(40, 40, 0.3);
+    Common::DenseMatrix B = makeTestMatrix(40, 40, 0.9);
+    Common::DenseMatrix C(50, 50, std::nan(""));
+    Common::MatrixView target = C.block(5, 5, 40, 40);
+
+    LinearAlgebra::gemm(1.0, A, B, 0.0, target);
+    Common::DenseMatrix expected = naiveGemm(false, false, 1.0, A, B, 0.0, Common::DenseMatrix(40, 40));
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 40; ++j) ASSERT_NEAR(target(i, j), expected(i, j), 1e-12);
+    EXPECT_TRUE(std::isnan(C(4, 4))); // poza widokiem nic nie zmieniono
+    EXPECT_TRUE(std::isnan(C(45, 45)));
+
+    EXPECT_THROW(LinearAlgebra::gemm(1.0, A, makeTestMatrix(39, 40, 0.0), 0.0, target), std::runtime_error);
+}
+
+
+// --- Testy obiektu LUFactorization ---
+
+TEST(LUFactorizationTest, FactorsOnceAndSolvesManyRightHandSides) {
+    Common::Matrix A = {{2, 1, 1}, {4, -6, 0}, {-2, 7, 2}};
+    LinearAlgebra::LUFactorization lu(A);
+    ASSERT_TRUE(lu.isFactored());
+    ASSERT_EQ(lu.size(), 3u);
+
+    for (int r = 0; r < 5; ++r) {
+        Common::ValueSeries x_true = {1.0 + r, -2.0 * r, 0.5};
+        Common::ValueSeries b(3, 0.0);
+        for (size_t i = 0; i < 3; ++i)
+            for (size_t j = 0; j < 3; ++j) b[i] += A[i][j] * x_true[j];
+
+        Common::ValueSeries x = lu.solve(b);
+        lu.solveInPlace(b);
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(x[i], x_true[i], 1e-12);
+            EXPECT_DOUBLE_EQ(b[i], x[i]);
+        }
+    }
+    EXPECT_NEAR(lu.determinant(), -16.0, 1e-12);
+}
+
+TEST(LUFactorizationTest, PackedFactorsReproducePermutedMatrix) {
+    Common::DenseMatrix A = makeTestMatrix(7, 7, 0.4);
+    LinearAlgebra::LUFactorization lu(A);
+
+    Common::DenseMatrix LU = LinearAlgebra::multiplyMatrices(lu.lower(), lu.upper());
+    Common::IndexVector P = lu.permutation();
+    for (size_t i = 0; i < 7; ++i)
+        for (size_t j = 0; j < 7; ++j) EXPECT_NEAR(LU(i, j), A(P[i], j), 1e-12);
+}
+
+TEST(LUFactorizationTest, ReportsSingularMatrix) {
+    Common::DenseMatrix A(Common::Matrix{{1, 2}, {2, 4}});
+    LinearAlgebra::LUFactorization lu;
+    EXPECT_FALSE(lu.factor(A));
+    EXPECT_FALSE(lu.isFactored());
+    EXPECT_THROW(lu.solve({1.0, 1.0}), std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::LUFactorization{A}, std::runtime_error);
+}
+
+TEST(LUFactorizationTest, BlockedThreadedFactorizationMatchesUnblocked) {
+    const size_t n = 203;
+    Common::DenseMatrix A = makeTestMatrix(n, n, 1.3);
+
+    LinearAlgebra::LUOptions unblocked;
+    unblocked.block_size = n;
+    LinearAlgebra::LUOptions blocked;
+    blocked.block_size = 16;
+    blocked.num_threads = 4;
+
+    LinearAlgebra::LUFactorization reference(A, unblocked);
+    LinearAlgebra::LUFactorization lu(A, blocked);
+    EXPECT_EQ(lu.pivots(), reference.pivots());
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) ASSERT_NEAR(lu.packedLU()(i, j), reference.packedLU()(i, j), 1e-9);
+
+    Common::ValueSeries b(n, 1.0);
+    Common::ValueSeries x = lu.solve(b);
+    for (size_t i = 0; i < n; ++i) {
+        double r = -b[i];
+        for (size_t j = 0; j < n; ++j) r += A(i, j) * x[j];
+        EXPECT_NEAR(r, 0.0, 1e-9);
+    }
+}
+
+TEST(GemmTest, ParallelMatchesSerial) {
+    Common::DenseMatrix A = makeTestMatrix(310, 120, 0.2);
+    Common::DenseMatrix B = makeTestMatrix(120, 290, 0.5);
+    Common::DenseMatrix C1 = makeTestMatrix(310, 290, 0.8), C2 = C1;
+
+    LinearAlgebra::gemm(2.0, A, B, -1.0, C1);
+    LinearAlgebra::gemmParallel(LinearAlgebra::Transpose::No, LinearAlgebra::Transpose::No, 2.0, A, B, -1.0, C2, 4);
+    for (size_t i = 0; i < C1.rows(); ++i)
+        for (size_t j = 0; j < C1.cols(); ++j) ASSERT_NEAR(C1(i, j), C2(i, j), 1e-12);
+}
+
+TEST(GemmTest, SinglePrecisionMatchesDoubleForAllKernels) {
+    const size_t m = 75, n = 97, k = 130;
+    Common::DenseMatrix A = makeTestMatrix(m, k, 0.4);
+    Common::DenseMatrix B = makeTestMatrix(k, n, 1.3);
+    Common::DenseMatrix expected(m, n);
+    LinearAlgebra::gemm(1.0, A, B, 0.0, expected);
+
+    std::vector<float> a(m * k), b(k * n);
+    for (size_t i = 0; i < m * k; ++i) a[i] = static_cast<float>(A.data()[i]);
+    for (size_t i = 0; i < k * n; ++i) b[i] = static_cast<float>(B.data()[i]);
+    const LinearAlgebra::GemmKernel kernels[] = {LinearAlgebra::GemmKernel::Scalar,
+                                                 LinearAlgebra::GemmKernel::AVX2,
+                                                 LinearAlgebra::GemmKernel::AVX512};
+    for (auto kernel : kernels) {
+        if (!LinearAlgebra::isGemmKernelSupported(kernel)) continue;
+        LinearAlgebra::setGemmKernel(kernel);
+        std::vector<float> c(m * n, std::nanf(""));
+        LinearAlgebra::gemmParallel(LinearAlgebra::Transpose::No, LinearAlgebra::Transpose::No, 1.0f,
+                                    Common::ConstFloatMatrixView(a.data(), m, k),
+                                    Common::ConstFloatMatrixView(b.data(), k, n),
+                                    0.0f, Common::FloatMatrixView(c.data(), m, n), 3);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j) ASSERT_NEAR(c[i * n + j], expected(i, j), 1e-4);
+    }
+    LinearAlgebra::setGemmKernel(LinearAlgebra::GemmKernel::Auto);
+}
+
+
+// --- Testy podstawiania dla wielu prawych stron ---
+
+TEST(TriangularSolveTest, InPlaceMatrixSubstitutionMatchesVectorVersion) {
+    const size_t n = 150, m = 37;
+    Common::DenseMatrix T = makeTestMatrix(n, n, 0.6);
+    for (size_t i = 0; i < n; ++i) T(i, i) += 4.0; // dobrze uwarunkowana przekątna
+    Common::DenseMatrix B = makeTestMatrix(n, m, 1.7);
+
+    Common::DenseMatrix X_lower = B;
+    LinearAlgebra::forwardSubstitutionInPlace(T, X_lower); // jedynki na przekątnej
+    Common::DenseMatrix X_upper = B;
+    LinearAlgebra::backwardSubstitutionInPlace(T, X_upper);
+
+    for (size_t c = 0; c < m; ++c) {
+        Common::ValueSeries b(n);
+        for (size_t i = 0; i < n; ++i) b[i] = B(i, c);
+        Common::ValueSeries y = LinearAlgebra::forwardSubstitution(T, b);
+        Common::ValueSeries x = LinearAlgebra::backwardSubstitution(T, b);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(X_lower(i, c), y[i], 1e-9 * (1.0 + std::abs(y[i])));
+            ASSERT_NEAR(X_upper(i, c), x[i], 1e-9 * (1.0 + std::abs(x[i])));
+        }
+    }
+}
+
+TEST(TriangularSolveTest, SolveWithLUHandlesManyRightHandSides) {
+    const size_t n = 90, m = 260;
+    Common::DenseMatrix A = makeTestMatrix(n, n, 2.2);
+    Common::DenseMatrix X_true = makeTestMatrix(n, m, 0.9);
+    Common::DenseMatrix B = LinearAlgebra::multiplyMatrices(A, X_true);
+
+    Common::DenseMatrix X = LinearAlgebra::solveWithLU(A, B);
+    ASSERT_EQ(X.rows(), n);
+    ASSERT_EQ(X.cols(), m);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < m; ++j) ASSERT_NEAR(X(i, j), X_true(i, j), 1e-8);
+
+    EXPECT_THROW(LinearAlgebra::solveWithLU(A, makeTestMatrix(n + 1, 2, 0.0)), std::runtime_error);
+}
+
+// --- Testy rozkładu LDL^T ---
+
+namespace {
+    // A = M M^T + n I jest symetryczna dodatnio określona
+    Common::DenseMatrix makeSPDMatrix(size_t n, double seed) {
+        Common::DenseMatrix M = makeTestMatrix(n, n, seed);
+        Common::DenseMatrix A(n, n);
+        LinearAlgebra::gemm(LinearAlgebra::Transpose::No, LinearAlgebra::Transpose::Yes, 1.0, M, M, 0.0, A);
+        for (size_t i = 0; i < n; ++i) A(i, i) += static_cast<double>(n);
+        return A;
+    }
+}
+
+TEST(LDLTFactorizationTest, SolveMatchesLU) {
+    const size_t n = 120;
+    Common::DenseMatrix A = makeSPDMatrix(n, 0.4);
+    Common::ValueSeries b(n);
+    for (size_t i = 0; i < n; ++i) b[i] = std::cos(0.3 * static_cast<double>(i));
+
+    Common::ValueSeries x_lu = LinearAlgebra::solveWithLU(A, b);
+    Common::ValueSeries x = LinearAlgebra::solve(A, b, LinearAlgebra::MatrixStructure::SymmetricPositiveDefinite);
+    ASSERT_EQ(x.size(), n);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(x[i], x_lu[i], 1e-10);
+
+    LinearAlgebra::LDLTFactorization ldlt(A);
+    LinearAlgebra::LUFactorization lu(A);
+    EXPECT_NEAR(ldlt.determinant() / lu.determinant(), 1.0, 1e-9);
+}
+
+TEST(LDLTFactorizationTest, BlockedThreadedMatchesUnblocked) {
+    const size_t n = 200;
+    Common::DenseMatrix A = makeSPDMatrix(n, 1.1);
+    LinearAlgebra::LDLTFactorization unblocked(A, {n, 1});
+    LinearAlgebra::LDLTFactorization blocked(A, {16, 4});
+    ASSERT_TRUE(unblocked.isFactored());
+    ASSERT_TRUE(blocked.isFactored());
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j <= i; ++j)
+            ASSERT_NEAR(blocked.packedLDLT()(i, j), unblocked.packedLDLT()(i, j), 1e-9);
+
+    Common::DenseMatrix X_true = makeTestMatrix(n, 5, 0.2);
+    Common::DenseMatrix X = blocked.solve(LinearAlgebra::multiplyMatrices(A, X_true));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < 5; ++j) ASSERT_NEAR(X(i, j), X_true(i, j), 1e-9);
+}
+
+TEST(LDLTFactorizationTest, ReadsOnlyLowerTriangle) {
+    const size_t n = 50;
+    Common::DenseMatrix A = makeSPDMatrix(n, 2.5);
+    Common::DenseMatrix A_lower = A;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j) A_lower(i, j) = std::nan("");
+
+    Common::ValueSeries b(n, 1.0);
+    Common::ValueSeries x = LinearAlgebra::LDLTFactorization(A).solve(b);
+    Common::ValueSeries x_lower = LinearAlgebra::LDLTFactorization(A_lower, {8, 1}).solve(b);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(x_lower[i], x[i], 1e-12);
+}
+
+TEST(LDLTFactorizationTest, RejectsIndefiniteMatrix) {
+    Common::Matrix A = {{1.0, 2.0}, {2.0, 1.0}};
+    LinearAlgebra::LDLTFactorization ldlt;
+    EXPECT_FALSE(ldlt.factor(Common::DenseMatrix(A)));
+    EXPECT_THROW(LinearAlgebra::LDLTFactorization{A}, std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::solve(A, {1.0, 1.0}, LinearAlgebra::MatrixStructure::SymmetricPositiveDefinite),
+                 std::runtime_error);
+    Common::ValueSeries x = LinearAlgebra::solve(A, {3.0, 3.0});
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NEAR(x[1], 1.0, 1e-12);
+}
+
+// --- Testy LU w mieszanej precyzji ---
+
+TEST(MixedPrecisionLUTest, RefinementReachesDoubleAccuracy) {
+    const size_t n = 300;
+    Common::DenseMatrix A = makeTestMatrix(n, n, 0.8);
+    for (size_t i = 0; i < n; ++i) A(i, i) += 10.0;
+    Common::ValueSeries x_true(n);
+    for (size_t i = 0; i < n; ++i) x_true[i] = std::sin(0.1 * static_cast<double>(i)) + 2.0;
+    Common::ValueSeries b(n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) b[i] += A(i, j) * x_true[j];
+
+    LinearAlgebra::MixedPrecisionResult result = LinearAlgebra::solveWithLU(A, b, LinearAlgebra::MixedPrecisionOptions());
+    EXPECT_FALSE(result.used_double_fallback);
+    EXPECT_GE(result.refinement_steps, 1u);
+    EXPECT_LE(result.refinement_steps, 5u);
+    EXPECT_LT(result.backward_error, 1e-14);
+    ASSERT_EQ(result.x.size(), n);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(result.x[i], x_true[i], 1e-11);
+}
+
+TEST(MixedPrecisionLUTest, ConditionEstimateMatchesExactNorm) {
+    const size_t n = 40;
+    Common::DenseMatrix A = makeTestMatrix(n, n, 1.9);
+    for (size_t i = 0; i < n; ++i) A(i, i) += 3.0;
+    Common::DenseMatrix A_inv = LinearAlgebra::solveWithLU(A, Common::DenseMatrix::identity(n));
+    double norm_A = 0.0, norm_inv = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        double col_A = 0.0, col_inv = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            col_A += std::abs(A(i, j));
+            col_inv += std::abs(A_inv(i, j));
+        }
+        norm_A = std::max(norm_A, col_A);
+        norm_inv = std::max(norm_inv, col_inv);
+    }
+    const double kappa = norm_A * norm_inv;
+
+    LinearAlgebra::MixedPrecisionResult result =
+            LinearAlgebra::solveWithLU(A, Common::ValueSeries(n, 1.0), LinearAlgebra::MixedPrecisionOptions());
+    // Estymator Hagera daje dolne ograniczenie, w praktyce bliskie dokładnej wartości
+    EXPECT_LE(result.condition_estimate, kappa * 1.001);
+    EXPECT_GE(result.condition_estimate, kappa * 0.3);
+}
+
+TEST(MixedPrecisionLUTest, FallsBackToDoubleForIllConditionedMatrix) {
+    const size_t n = 10; // macierz Hilberta, kappa ~ 1e13 >> 1 / eps_float
+    Common::DenseMatrix H(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) H(i, j) = 1.0 / static_cast<double>(i + j + 1);
+    Common::ValueSeries b(n, 1.0);
+
+    LinearAlgebra::MixedPrecisionResult result = LinearAlgebra::solveWithLU(H, b, LinearAlgebra::MixedPrecisionOptions());
+    EXPECT_TRUE(result.used_double_fallback);
+    EXPECT_GT(result.condition_estimate, 1e8);
+    Common::ValueSeries x_double = LinearAlgebra::solveWithLU(Common::ConstMatrixView(H), b);
+    for (size_t i = 0; i < n; ++i) EXPECT_DOUBLE_EQ(result.x[i], x_double[i]);
+
+    Common::DenseMatrix singular(3, 3, 1.0);
+    EXPECT_THROW(LinearAlgebra::solveWithLU(singular, {1.0, 2.0, 3.0}, LinearAlgebra::MixedPrecisionOptions()),
+                 std::runtime_error);
+}
+
+// --- Testy rozkładu QR i najmniejszych kwadratów ---
+
+TEST(QRFactorizationTest, BlockedFactorsReproduceMatrix) {
+    const size_t m = 130, n = 70;
+    Common::DenseMatrix A = makeTestMatrix(m, n, 0.9);
+    LinearAlgebra::QRFactorization qr(A, {16, 2});
+    Common::DenseMatrix Q = qr.thinQ();
+    Common::DenseMatrix R = qr.R();
+
+    Common::DenseMatrix QR = LinearAlgebra::multiplyMatrices(Q, R);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) ASSERT_NEAR(QR(i, j), A(i, j), 1e-12);
+
+    Common::DenseMatrix QtQ(n, n);
+    LinearAlgebra::gemm(LinearAlgebra::Transpose::Yes, LinearAlgebra::Transpose::No, 1.0, Q, Q, 0.0, QtQ);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) ASSERT_NEAR(QtQ(i, j), i == j ? 1.0 : 0.0, 1e-13);
+
+    LinearAlgebra::QRFactorization unblocked(A, {n, 1});
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i; j < n; ++j) ASSERT_NEAR(unblocked.R()(i, j), R(i, j), 1e-12);
+}
+
+TEST(QRFactorizationTest, LeastSquaresMatchesNormalEquationsAndReportsResidual) {
+    const size_t m = 200, n = 12;
+    Common::DenseMatrix A = makeTestMatrix(m, n, 0.3);
+    Common::ValueSeries b(m);
+    for (size_t i = 0; i < m; ++i) b[i] = std::cos(0.05 * static_cast<double>(i));
+
+    LinearAlgebra::LeastSquaresResult result = LinearAlgebra::QRFactorization(A).solveLeastSquares(b);
+
+    Common::DenseMatrix AtA(n, n);
+    LinearAlgebra::gemm(LinearAlgebra::Transpose::Yes, LinearAlgebra::Transpose::No, 1.0, A, A, 0.0, AtA);
+    Common::ValueSeries Atb(n, 0.0);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) Atb[j] += A(i, j) * b[i];
+    Common::ValueSeries x_ne = LinearAlgebra::solve(AtA, Atb, LinearAlgebra::MatrixStructure::SymmetricPositiveDefinite);
+    for (size_t j = 0; j < n; ++j) EXPECT_NEAR(result.x[j], x_ne[j], 1e-8);
+
+    double sum_sq = 0.0;
+    for (size_t i = 0; i < m; ++i) {
+        double r = b[i];
+        for (size_t j = 0; j < n; ++j) r -= A(i, j) * result.x[j];
+        sum_sq += r * r;
+    }
+    EXPECT_NEAR(result.residual_norm, std::sqrt(sum_sq), 1e-12);
+}
+
+TEST(QRFactorizationTest, TallSystemAndIncrementalRowsAgree) {
+    const size_t m = 6000, n = 5;
+    Common::DenseMatrix A(m, n);
+    Common::ValueSeries b(m);
+    for (size_t i = 0; i < m; ++i) {
+        double t = static_cast<double>(i) / m;
+        for (size_t j = 0; j < n; ++j) A(i, j) = std::pow(t, static_cast<double>(j));
+        b[i] = 1.0 - 2.0 * t + 0.5 * t * t + 0.01 * std::sin(40.0 * t);
+    }
+    LinearAlgebra::LeastSquaresResult reference = LinearAlgebra::QRFactorization(A).solveLeastSquares(b);
+    LinearAlgebra::LeastSquaresResult tall = LinearAlgebra::leastSquares(A, b, {32, 3});
+
+    LinearAlgebra::IncrementalLeastSquares first(n), second(n);
+    for (size_t i = 0; i < m / 2; ++i) first.addRow(Common::ValueSeries(A.rowPtr(i), A.rowPtr(i) + n), b[i]);
+    second.addRows(A.block(m / 2, 0, m - m / 2, n), Common::ValueSeries(b.begin() + m / 2, b.end()));
+    first.merge(second);
+    EXPECT_EQ(first.observations(), m);
+    LinearAlgebra::LeastSquaresResult incremental = first.solve();
+
+    for (size_t j = 0; j < n; ++j) {
+        EXPECT_NEAR(tall.x[j], reference.x[j], 1e-9);
+        EXPECT_NEAR(incremental.x[j], reference.x[j], 1e-9);
+    }
+    EXPECT_NEAR(tall.residual_norm, reference.residual_norm, 1e-10);
+    EXPECT_NEAR(incremental.residual_norm, reference.residual_norm, 1e-10);
+    EXPECT_NEAR(first.residualNorm(), reference.residual_norm, 1e-10);
+}
+
+TEST(QRFactorizationTest, RejectsRankDeficientAndWideSystems) {
+    Common::Matrix A = {{1.0, 2.0}, {2.0, 4.0}, {3.0, 6.0}};
+    EXPECT_THROW(LinearAlgebra::leastSquares(A, {1.0, 2.0, 3.0}), std::runtime_error);
+    EXPECT_THROW(LinearAlgebra::QRFactorization(Common::Matrix{{1.0, 2.0, 3.0}}), std::runtime_error);
+
+    LinearAlgebra::IncrementalLeastSquares ls(3);
+    ls.addRow({1.0, 0.0, 0.0}, 1.0);
+    EXPECT_THROW(ls.solve(), std::runtime_error);
+    EXPECT_THROW(ls.addRow({1.0, 2.0}, 1.0), std::runtime_error);
+}
+
+// --- Eliminacja Gaussa w miejscu ---
+
+TEST(LinearAlgebraTest, GaussEliminationInPlaceUsesCallerStorageAndNotifiesObserver) {
+    const size_t n = 30;
+    Common::DenseMatrix A = makeTestMatrix(n, n, 1.4);
+    Common::ValueSeries b(n);
+    for (size_t i = 0; i < n; ++i) b[i] = std::sin(0.2 * static_cast<double>(i));
+    Common::ValueSeries expected = LinearAlgebra::solveWithLU(Common::ConstMatrixView(A), b);
+
+    Common::DenseMatrix work = A;
+    Common::ValueSeries x = b;
+    std::vector<size_t> steps;
+    LinearAlgebra::gaussEliminationInPlace(work, x, [&](const LinearAlgebra::GaussStep& step) {
+        EXPECT_EQ(step.A.data(), work.data()); // obserwator widzi pamięć wywołującego
+        EXPECT_EQ(step.pivot, step.A(step.step, step.step));
+        EXPECT_GE(step.pivot_row, step.step);
+        steps.push_back(step.step);
+    });
+
+    ASSERT_EQ(steps.size(), n);
+    for (size_t k = 0; k < n; ++k) EXPECT_EQ(steps[k], k);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(x[i], expected[i], 1e-9);
+        for (size_t j = 0; j < i; ++j) EXPECT_EQ(work(i, j), 0.0);
+    }
+}
+
+TEST(LinearAlgebraTest, GaussEliminationIsQuietUnlessObserved) {
+    Common::Matrix A = {{2, 1}, {1, 3}};
+    Common::ValueSeries b = {4, 7};
+    testing::internal::CaptureStdout();
+    LinearAlgebra::gaussElimination(A, b);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+    std::ostringstream log;
+    Common::ValueSeries x = LinearAlgebra::gaussElimination(A, b, LinearAlgebra::printingGaussObserver(log));
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NE(log.str().find("Krok 2"), std::string::npos);
+}
+
+// --- Diagnostyka rozkładów ---
+
+namespace {
+    double exactCondition1(Common::ConstMatrixView A) {
+        const size_t n = A.rows();
+        Common::DenseMatrix A_inv = LinearAlgebra::solveWithLU(A, Common::DenseMatrix::identity(n));
+        return LinearAlgebra::matrixNorm1(A) * LinearAlgebra::matrixNorm1(A_inv);
+    }
+}
+
+TEST(FactorizationDiagnosticsTest, ConditionEstimateTracksExactValue) {
+    Common::DenseMatrix A = makeTestMatrix(60, 60, 0.7);
+    for (size_t i = 0; i < 60; ++i) A(i, i) += 2.0;
+    const double kappa = exactCondition1(A);
+    LinearAlgebra::FactorizationDiagnostics d = LinearAlgebra::LUFactorization(A).diagnostics();
+    EXPECT_LE(d.condition_estimate, kappa * (1.0 + 1e-10));
+    EXPECT_GE(d.condition_estimate, kappa * 0.3);
+    EXPECT_NEAR(d.reciprocal_condition * d.condition_estimate, 1.0, 1e-12);
+
+    Common::DenseMatrix H(8, 8); // macierz Hilberta, kappa_1 ~ 3.4e10
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 8; ++j) H(i, j) = 1.0 / static_cast<double>(i + j + 1);
+    LinearAlgebra::FactorizationDiagnostics dh;
+    Common::DenseMatrix L, U;
+    Common::IndexVector P;
+    ASSERT_TRUE(LinearAlgebra::luDecompositionPivoting(H, L, U, P, &dh));
+    const double kappa_h = exactCondition1(H);
+    EXPECT_GT(dh.condition_estimate, kappa_h / 3.0);
+    EXPECT_LT(dh.condition_estimate, kappa_h * 1.01);
+    EXPECT_LT(dh.reciprocal_condition, 1e-9);
+}
+
+TEST(FactorizationDiagnosticsTest, PivotGrowthOfWilkinsonMatrix) {
+    const size_t n = 20; // 1 na przekątnej, -1 pod nią, 1 w ostatniej kolumnie: wzrost 2^(n-1)
+    Common::DenseMatrix W(n, n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        W(i, i) = 1.0;
+        W(i, n - 1) = 1.0;
+        for (size_t j = 0; j < i; ++j) W(i, j) = -1.0;
+    }
+    LinearAlgebra::FactorizationDiagnostics d = LinearAlgebra::LUFactorization(W).diagnostics();
+    EXPECT_DOUBLE_EQ(d.pivot_growth, std::pow(2.0, static_cast<double>(n - 1)));
+
+    LinearAlgebra::FactorizationDiagnostics d_id = LinearAlgebra::LUFactorization(Common::DenseMatrix::identity(5)).diagnostics();
+    EXPECT_DOUBLE_EQ(d_id.pivot_growth, 1.0);
+    EXPECT_NEAR(d_id.condition_estimate, 1.0, 1e-12);
+}
+
+TEST(FactorizationDiagnosticsTest, LDLTDiagnosticsForSPDMatrix) {
+    Common::DenseMatrix A = makeSPDMatrix(80, 0.5);
+    LinearAlgebra::FactorizationDiagnostics d_ldlt = LinearAlgebra::LDLTFactorization(A).diagnostics();
+    LinearAlgebra::FactorizationDiagnostics d_lu = LinearAlgebra::LUFactorization(A).diagnostics();
+    EXPECT_NEAR(d_ldlt.norm1, d_lu.norm1, 1e-9 * d_lu.norm1);
+    EXPECT_NEAR(d_ldlt.condition_estimate, d_lu.condition_estimate, 1e-6 * d_lu.condition_estimate);
+    EXPECT_LE(d_ldlt.pivot_growth, 1.0 + 1e-12); // eliminacja macierzy SPD nie zwiększa elementów
+    EXPECT_GT(d_ldlt.pivot_growth, 0.0);
+}
@@ -46,4 +46,18 @@ TEST(ODETest, GetSolutionAtTime) {
 TEST(ODETest, GetSolutionAtTimeOutOfBoundsIsNaN) {
     MeteoNumerical::ODE::ODESolution solution = {{0.0, 1.0}, {0.1, 1.1}};
     EXPECT_TRUE(std::isnan(MeteoNumerical::ODE::getSolutionAtTime(solution, 0.2)));
-}
\ No newline at end of file
+}
+
+TEST(ODETest, CallableOverloadsMatchStdFunction) {
+    double rate = -0.7;
+    auto decay = [rate](double, double y) { return rate * y; };
+    MeteoNumerical::ODE::ODEFunction wrapped = decay;
+    for (const char* method : {"euler", "heun", "midpoint", "rk4"}) {
+        auto a = MeteoNumerical::ODE::solve(decay, 0.0, 2.0, 1.05, 0.1, method);
+        auto b = MeteoNumerical::ODE::solve(wrapped, 0.0, 2.0, 1.05, 0.1, method);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_EQ(a[i].second, b[i].second);
+    }
+    auto rk4 = MeteoNumerical::ODE::solve(decay, 0.0, 2.0, 1.0, 0.01);
+    EXPECT_NEAR(rk4.back().second, 2.0 * std::exp(-0.7), 1e-10);
+}
@@ -51,3 +51,16 @@ TEST(RootFindingTest, SecantMethod) {
     double root = MeteoNumerical::RootFinding::secant_method(parabola, 4.0, 5.0, 1e-7, 100, iterations);
     EXPECT_NEAR(root, 2.0, 1e-7);
 }
+
+TEST(RootFindingTest, CallableOverloadsAcceptLambdas) {
+    MeteoNumerical::Common::ValueSeries a, b;
+    double shift = 3.0;
+    auto f = [shift](double x) { return x * x - shift; };
+    auto df = [](double x) { return 2.0 * x; };
+    MeteoNumerical::RootFinding::RootFunction wrapped = f;
+    EXPECT_NEAR(MeteoNumerical::RootFinding::newton_method_analytic(f, df, 1.0, 1e-12, 50, a), std::sqrt(3.0), 1e-12);
+    EXPECT_EQ(MeteoNumerical::RootFinding::bisection_method(f, 0.0, 3.0, 1e-10, 100, a),
+              MeteoNumerical::RootFinding::bisection_method(wrapped, 0.0, 3.0, 1e-10, 100, b));
+    EXPECT_EQ(a, b);
+    EXPECT_NEAR(MeteoNumerical::RootFinding::regula_falsi_method(f, 0.0, 3.0, 1e-12, 200, a), std::sqrt(3.0), 1e-9);
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "sparse.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeteoNumerical;
+
+namespace {
+// Dyskretny laplasjan 2D (5-punktowy) na siatce nx x ny - symetryczny, dodatnio określony
+LinearAlgebra::CSRMatrix poisson2D(size_t nx, size_t ny) {
+    std::vector<LinearAlgebra::Triplet> t;
+    for (size_t j = 0; j < ny; ++j) {
+        for (size_t i = 0; i < nx; ++i) {
+            size_t row = j * nx + i;
+            t.push_back({row, row, 4.0});
+            if (i > 0) t.push_back({row, row - 1, -1.0});
+            if (i + 1 < nx) t.push_back({row, row + 1, -1.0});
+            if (j > 0) t.push_back({row, row - nx, -1.0});
+            if (j + 1 < ny) t.push_back({row, row + nx, -1.0});
+        }
+    }
+    return LinearAlgebra::CSRMatrix::fromTriplets(nx * ny, nx * ny, t);
+}
+} // namespace
+
+TEST(SparseTest, FromTripletsSumsDuplicatesAndConvertsToCSC) {
+    std::vector<LinearAlgebra::Triplet> t = {{1, 2, 3.0}, {0, 0, 1.0}, {1, 2, 2.0}, {2, 1, -4.0}, {0, 2, 7.0}};
+    LinearAlgebra::CSRMatrix A = LinearAlgebra::CSRMatrix::fromTriplets(3, 3, t);
+    EXPECT_EQ(A.nonZeros(), 4u);
+    EXPECT_DOUBLE_EQ(A.get(1, 2), 5.0);
+    EXPECT_DOUBLE_EQ(A.get(1, 1), 0.0);
+
+    Common::ValueSeries x = {1.0, 2.0, 3.0};
+    Common::ValueSeries y = A.multiply(x);
+    EXPECT_DOUBLE_EQ(y[0], 22.0);
+    EXPECT_DOUBLE_EQ(y[1], 15.0);
+    EXPECT_DOUBLE_EQ(y[2], -8.0);
+    EXPECT_EQ(A.toCSC().multiply(x), y);
+    EXPECT_EQ(A.toCSC().toCSR().multiply(x), y);
+
+    EXPECT_THROW(LinearAlgebra::CSRMatrix::fromTriplets(2, 2, {{2, 0, 1.0}}), std::out_of_range);
+}
+
+TEST(SparseTest, ParallelSpMVMatchesSerial) {
+    LinearAlgebra::CSRMatrix A = poisson2D(500, 420); // powyżej progu równoległego SpMV
+    Common::ValueSeries x(A.cols());
+    for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(0.01 * i);
+    EXPECT_EQ(A.multiply(x, 1), A.multiply(x, 4));
+}
+
+TEST(SparseTest, PreconditionedCGSolvesPoissonProblem) {
+    LinearAlgebra::CSRMatrix A = poisson2D(40, 40);
+    Common::ValueSeries x_true(A.rows());
+    for (size_t i = 0; i < x_true.size(); ++i) x_true[i] = std::cos(0.05 * i);
+    Common::ValueSeries b = A.multiply(x_true);
+
+    LinearAlgebra::IterativeSolverOptions opts;
+    opts.tolerance = 1e-12;
+    auto plain = LinearAlgebra::conjugateGradient(A, b, opts);
+    auto jacobi = LinearAlgebra::conjugateGradient(A, b, LinearAlgebra::JacobiPreconditioner(A), opts);
+    auto ilu = LinearAlgebra::conjugateGradient(A, b, LinearAlgebra::ILU0Preconditioner(A), opts);
+
+    for (const auto* res : {&plain, &jacobi, &ilu}) {
+        ASSERT_TRUE(res->converged);
+        EXPECT_EQ(res->residual_history.size(), static_cast<size_t>(res->iterations) + 1);
+        for (size_t i = 0; i < x_true.size(); ++i) ASSERT_NEAR(res->x[i], x_true[i], 1e-9);
+    }
+    EXPECT_LT(ilu.iterations, plain.iterations); // ILU(0) przyspiesza zbieżność
+}
+
+TEST(SparseTest, GMRESSolvesNonsymmetricSystem) {
+    // Konwekcja-dyfuzja: niesymetryczna macierz pasmowa
+    const size_t n = 400;
+    std::vector<LinearAlgebra::Triplet> t;
+    for (size_t i = 0; i < n; ++i) {
+        t.push_back({i, i, 3.0});
+        if (i > 0) t.push_back({i, i - 1, -1.6});
+        if (i + 1 < n) t.push_back({i, i + 1, -0.4});
+    }
+    LinearAlgebra::CSRMatrix A = LinearAlgebra::CSRMatrix::fromTriplets(n, n, t);
+    Common::ValueSeries x_true(n);
+    for (size_t i = 0; i < n; ++i) x_true[i] = 1.0 + std::sin(0.1 * i);
+    Common::ValueSeries b = A.multiply(x_true);
+
+    LinearAlgebra::IterativeSolverOptions opts;
+    opts.tolerance = 1e-11;
+    opts.restart = 20;
+    auto plain = LinearAlgebra::gmres(A, b, opts);
+    auto ilu = LinearAlgebra::gmres(A, b, LinearAlgebra::ILU0Preconditioner(A), opts);
+    ASSERT_TRUE(plain.converged);
+    ASSERT_TRUE(ilu.converged);
+    EXPECT_LE(ilu.iterations, 2); // ILU(0) dla macierzy trójdiagonalnej jest dokładne
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_NEAR(plain.x[i], x_true[i], 1e-9);
+        ASSERT_NEAR(ilu.x[i], x_true[i], 1e-9);
+    }
+    EXPECT_THROW(LinearAlgebra::gmres(A, Common::ValueSeries(n + 1), opts), std::runtime_error);
+}
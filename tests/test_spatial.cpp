@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "spatial.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+using namespace MeteoNumerical;
+
+namespace {
+    std::vector<DataStructures::StationLocation> randomStations(size_t n, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 100.0);
+        std::vector<DataStructures::StationLocation> s;
+        for (size_t i = 0; i < n; ++i) s.emplace_back(u(gen), u(gen));
+        return s;
+    }
+}
+
+TEST(KDTree2DTest, NearestMatchesBruteForce) {
+    auto stations = randomStations(3000, 7);
+    Interpolation::KDTree2D tree(stations);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> u(-10.0, 110.0);
+    for (int q = 0; q < 200; ++q) {
+        double x = u(gen), y = u(gen);
+        std::vector<std::pair<double, size_t>> all;
+        for (size_t i = 0; i < stations.size(); ++i) {
+            double dx = stations[i].x - x, dy = stations[i].y - y;
+            all.push_back({dx * dx + dy * dy, i});
+        }
+        std::sort(all.begin(), all.end());
+        auto found = tree.nearest(x, y, 10);
+        ASSERT_EQ(found.size(), 10u);
+        for (size_t j = 0; j < 10; ++j) {
+            EXPECT_DOUBLE_EQ(found[j].distance_sq, all[j].first);
+            EXPECT_EQ(found[j].index, all[j].second);
+        }
+    }
+    EXPECT_EQ(tree.nearest(0.0, 0.0, 5000).size(), 3000u);
+}
+
+TEST(SpatialInterpolatorTest, InverseDistanceMatchesShepardOverAllStations) {
+    auto stations = randomStations(40, 11);
+    Common::ValueSeries values;
+    for (const auto& s : stations) values.push_back(std::sin(0.1 * s.x) + 0.02 * s.y);
+    Interpolation::SpatialInterpolator interp(stations, values);
+    Interpolation::SpatialInterpolationOptions opts;
+    opts.neighbors = 40;
+    opts.power = 3.0;
+    for (double x = 5.0; x < 100.0; x += 13.7) {
+        for (double y = 2.0; y < 100.0; y += 17.3) {
+            double num = 0.0, den = 0.0;
+            for (size_t i = 0; i < stations.size(); ++i) {
+                double d = std::hypot(stations[i].x - x, stations[i].y - y);
+                num += values[i] / (d * d * d);
+                den += 1.0 / (d * d * d);
+            }
+            EXPECT_NEAR(interp.evaluate(x, y, Interpolation::SpatialMethod::InverseDistance, opts), num / den, 1e-12);
+        }
+    }
+    EXPECT_DOUBLE_EQ(interp.evaluate(stations[5].x, stations[5].y), values[5]);
+}
+
+TEST(SpatialInterpolatorTest, NaturalNeighborReproducesLinearField) {
+    auto stations = randomStations(2000, 5);
+    Common::ValueSeries values;
+    for (const auto& s : stations) values.push_back(3.0 + 0.5 * s.x - 0.25 * s.y);
+    Interpolation::SpatialInterpolator interp(stations, values);
+    Interpolation::SpatialInterpolationOptions opts;
+    opts.neighbors = 24;
+    for (double x = 10.0; x <= 90.0; x += 3.1) {
+        for (double y = 10.0; y <= 90.0; y += 2.9) {
+            EXPECT_NEAR(interp.evaluate(x, y, Interpolation::SpatialMethod::NaturalNeighbor, opts),
+                        3.0 + 0.5 * x - 0.25 * y, 1e-9);
+        }
+    }
+}
+
+TEST(SpatialInterpolatorTest, ParallelGridFillMatchesPointQueries) {
+    auto stations = randomStations(500, 9);
+    Common::ValueSeries values;
+    for (const auto& s : stations) values.push_back(std::cos(0.05 * s.x) * std::sin(0.07 * s.y));
+    Interpolation::SpatialInterpolator interp(stations, values);
+    Interpolation::RegularGrid2D grid;
+    grid.x0 = -5.0;
+    grid.y0 = 0.5;
+    grid.dx = 2.5;
+    grid.dy = 3.0;
+    grid.nx = 45;
+    grid.ny = 33;
+    Interpolation::SpatialInterpolationOptions opts;
+    opts.num_threads = 4;
+    for (auto method : {Interpolation::SpatialMethod::InverseDistance, Interpolation::SpatialMethod::NaturalNeighbor}) {
+        Common::DenseMatrix g = interp.fillGrid(grid, method, opts);
+        ASSERT_EQ(g.rows(), grid.ny);
+        ASSERT_EQ(g.cols(), grid.nx);
+        for (size_t j = 0; j < grid.ny; j += 4) {
+            for (size_t i = 0; i < grid.nx; i += 3) {
+                EXPECT_DOUBLE_EQ(g(j, i), interp.evaluate(grid.x0 + i * grid.dx, grid.y0 + j * grid.dy, method, opts));
+            }
+        }
+    }
+    opts.max_distance = 1e-3;
+    EXPECT_TRUE(std::isnan(interp.evaluate(-50.0, -50.0, Interpolation::SpatialMethod::InverseDistance, opts)));
+}
+
+TEST(SpatialInterpolatorTest, ThrowsOnInvalidInput) {
+    std::vector<DataStructures::StationLocation> stations = {{0.0, 0.0}, {1.0, 0.0}};
+    EXPECT_THROW(Interpolation::SpatialInterpolator(stations, {1.0}), std::runtime_error);
+    EXPECT_THROW(Interpolation::SpatialInterpolator({}, {}), std::runtime_error);
+    EXPECT_THROW(Interpolation::SpatialInterpolator({{0.0, NAN}}, {1.0}), std::runtime_error);
+    Interpolation::SpatialInterpolator interp(stations, {1.0, 2.0});
+    EXPECT_THROW(interp.setValues({1.0, NAN}), std::runtime_error);
+    Interpolation::SpatialInterpolationOptions opts;
+    opts.neighbors = 0;
+    EXPECT_THROW(interp.evaluate(0.5, 0.5, Interpolation::SpatialMethod::InverseDistance, opts), std::runtime_error);
+    Interpolation::RegularGrid2D grid;
+    grid.dx = 0.0;
+    EXPECT_THROW(interp.fillGrid(grid), std::runtime_error);
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "spline.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace MeteoNumerical;
+
+namespace {
+    double cubic(double x) { return 0.5 * x * x * x - 2.0 * x * x + x - 3.0; }
+    double cubicSlope(double x) { return 1.5 * x * x - 4.0 * x + 1.0; }
+
+    // Węzły nierównomierne na [0, 2 pi]
+    Common::ValueSeries irregularNodes(size_t n) {
+        Common::ValueSeries x(n);
+        const double two_pi = 2.0 * std::acos(-1.0);
+        for (size_t i = 0; i < n; ++i) {
+            double t = static_cast<double>(i) / (n - 1);
+            x[i] = two_pi * (t + 0.03 * std::sin(7.0 * t) * (i > 0 && i + 1 < n));
+        }
+        return x;
+    }
+}
+
+TEST(CubicSplineTest, NotAKnotAndClampedReproduceCubic) {
+    Common::ValueSeries x = {-1.0, -0.2, 0.5, 1.7, 2.0, 3.1};
+    Common::ValueSeries y;
+    for (double xi : x) y.push_back(cubic(xi));
+    Interpolation::CubicSpline not_a_knot(x, y, Interpolation::SplineBoundary::NotAKnot);
+    Interpolation::CubicSpline clamped(x, y, Interpolation::SplineBoundary::Clamped, cubicSlope(-1.0), cubicSlope(3.1));
+    for (double xp = -1.0; xp <= 3.1; xp += 0.037) {
+        EXPECT_NEAR(not_a_knot(xp), cubic(xp), 1e-11);
+        EXPECT_NEAR(clamped(xp), cubic(xp), 1e-11);
+        EXPECT_NEAR(clamped.derivative(xp), cubicSlope(xp), 1e-10);
+        EXPECT_NEAR(not_a_knot.secondDerivative(xp), 3.0 * xp - 4.0, 1e-9);
+    }
+    // Całka wielomianu: x^4/8 - 2x^3/3 + x^2/2 - 3x
+    auto F = [](double t) { return t * t * t * t / 8.0 - 2.0 * t * t * t / 3.0 + t * t / 2.0 - 3.0 * t; };
+    EXPECT_NEAR(not_a_knot.integral(-0.7, 2.9), F(2.9) - F(-0.7), 1e-11);
+    EXPECT_NEAR(not_a_knot.integral(2.9, -0.7), F(-0.7) - F(2.9), 1e-11);
+}
+
+TEST(CubicSplineTest, NaturalSplineInterpolatesWithZeroCurvatureAtEnds) {
+    Common::ValueSeries x = irregularNodes(40), y;
+    for (double xi : x) y.push_back(std::sin(xi));
+    Interpolation::CubicSpline s(x, y);
+    EXPECT_FALSE(s.isUniform());
+    for (size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(s(x[i]), y[i], 1e-14);
+    EXPECT_NEAR(s.secondDerivative(x.front()), 0.0, 1e-12);
+    EXPECT_NEAR(s.secondDerivative(x.back()), 0.0, 1e-12);
+    for (double xp = 0.5; xp < 5.5; xp += 0.1) {
+        EXPECT_NEAR(s(xp), std::sin(xp), 1e-4);
+        EXPECT_NEAR(s.derivative(xp), std::cos(xp), 2e-3);
+    }
+    EXPECT_NEAR(s.integral(0.0, std::acos(-1.0)), 2.0, 1e-4);
+}
+
+TEST(CubicSplineTest, UniformGridUsesDirectLookup) {
+    const size_t n = 101;
+    Common::ValueSeries y(n), x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 10.0 + 0.25 * i;
+        y[i] = std::cos(0.3 * x[i]);
+    }
+    Interpolation::CubicSpline a = Interpolation::CubicSpline::uniform(10.0, 0.25, y, Interpolation::SplineBoundary::NotAKnot);
+    Interpolation::CubicSpline b(x, y, Interpolation::SplineBoundary::NotAKnot);
+    EXPECT_TRUE(a.isUniform());
+    EXPECT_TRUE(b.isUniform());
+    EXPECT_EQ(a.findSegment(9.0), 0u);
+    EXPECT_EQ(a.findSegment(10.3), 1u);
+    EXPECT_EQ(a.findSegment(40.0), n - 2);
+    for (double xp = 9.5; xp < 36.0; xp += 0.173) {
+        EXPECT_NEAR(a(xp), b(xp), 1e-12);
+        if (xp >= 10.0 && xp <= 35.0) {
+            EXPECT_NEAR(a(xp), std::cos(0.3 * xp), 1e-6);
+        }
+    }
+}
+
+TEST(CubicSplineTest, BinarySearchFindsSegments) {
+    Common::ValueSeries x = {0.0, 0.1, 0.5, 0.6, 2.0, 3.5, 3.6, 7.0};
+    Common::ValueSeries y(x.size(), 1.0);
+    Interpolation::CubicSpline s(x, y);
+    EXPECT_EQ(s.findSegment(-5.0), 0u);
+    EXPECT_EQ(s.findSegment(0.0), 0u);
+    EXPECT_EQ(s.findSegment(0.55), 2u);
+    EXPECT_EQ(s.findSegment(0.6), 3u);
+    EXPECT_EQ(s.findSegment(3.59), 5u);
+    EXPECT_EQ(s.findSegment(7.0), 6u);
+    EXPECT_EQ(s.findSegment(100.0), 6u);
+}
+
+TEST(CubicSplineTest, BatchMatchesScalarForUnsortedPoints) {
+    Common::ValueSeries x = irregularNodes(25), y;
+    for (double xi : x) y.push_back(std::exp(-0.2 * xi) * std::sin(2.0 * xi));
+    Interpolation::CubicSpline s(x, y, Interpolation::SplineBoundary::NotAKnot);
+    Common::ValueSeries points;
+    for (int i = 0; i < 200; ++i) points.push_back(-0.5 + 7.3 * std::fmod(i * 0.618034, 1.0));
+    for (int i = 0; i < 50; ++i) points.push_back(0.12 * i); // rosnący fragment
+    Common::ValueSeries values = s.evaluate(points);
+    Common::ValueSeries slopes(points.size());
+    s.derivative(points.data(), slopes.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_DOUBLE_EQ(values[i], s(points[i]));
+        EXPECT_DOUBLE_EQ(slopes[i], s.derivative(points[i]));
+    }
+}
+
+TEST(CubicSplineTest, SmallNodeCounts) {
+    Interpolation::CubicSpline line({0.0, 2.0}, {1.0, 5.0});
+    EXPECT_NEAR(line(1.5), 4.0, 1e-14);
+    Interpolation::CubicSpline hermite({0.0, 1.0}, {0.0, 1.0}, Interpolation::SplineBoundary::Clamped, 0.0, 3.0);
+    EXPECT_NEAR(hermite(0.5), 0.125, 1e-14); // x^3
+    Interpolation::CubicSpline parabola({0.0, 1.0, 3.0}, {0.0, 1.0, 9.0}, Interpolation::SplineBoundary::NotAKnot);
+    EXPECT_NEAR(parabola(2.0), 4.0, 1e-13);
+    Interpolation::CubicSpline four({0.0, 1.0, 2.0, 4.0}, {0.0, 1.0, 8.0, 64.0}, Interpolation::SplineBoundary::NotAKnot);
+    EXPECT_NEAR(four(3.0), 27.0, 1e-12);
+}
+
+TEST(CubicSplineTest, ThrowsOnInvalidInput) {
+    EXPECT_THROW(Interpolation::CubicSpline({0.0}, {1.0}), std::runtime_error);
+    EXPECT_THROW(Interpolation::CubicSpline({0.0, 1.0}, {1.0}), std::runtime_error);
+    EXPECT_THROW(Interpolation::CubicSpline({0.0, 1.0, 1.0}, {1.0, 2.0, 3.0}), std::runtime_error);
+    EXPECT_THROW(Interpolation::CubicSpline({0.0, NAN}, {1.0, 2.0}), std::runtime_error);
+    EXPECT_THROW(Interpolation::CubicSpline::uniform(0.0, 0.0, {1.0, 2.0}), std::runtime_error);
+    Interpolation::CubicSpline empty;
+    EXPECT_THROW(empty(0.5), std::runtime_error);
+}
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "statistics.hpp"
+#include "pca.hpp"
+#include <stdexcept>
 #include <vector>
 #include <cmath> // Dla std::isnan
 
@@ -67,4 +69,102 @@ TEST(StatisticsTest, CalculateMSEWithMismatchedSizesIsNaN) {
     MeteoNumerical::Common::ValueSeries y_true = {1.0, 2.0, 3.0};
     MeteoNumerical::Common::ValueSeries y_pred = {1.5, 2.5};
     EXPECT_TRUE(std::isnan(MeteoNumerical::Statistics::calculate_mse(y_true, y_pred)));
-}
\ No newline at end of file
+}
+
+TEST(PCATest, RecoversDominantDirection) {
+    // Dane leżą prawie na prostej (1, 2): pierwsza składowa wyjaśnia niemal całą wariancję
+    Common::DenseMatrix data(200, 2);
+    for (size_t i = 0; i < 200; ++i) {
+        double t = std::sin(0.1 * i) * 5.0;
+        double noise = 0.01 * std::cos(1.7 * i);
+        data(i, 0) = 10.0 + t - 2.0 * noise;
+        data(i, 1) = -3.0 + 2.0 * t + noise;
+    }
+    Statistics::PCAResult pca = Statistics::principalComponents(data.view());
+    ASSERT_EQ(pca.variances.size(), 2u);
+    EXPECT_GT(pca.explained_variance_ratio[0], 0.9999);
+    EXPECT_NEAR(pca.explained_variance_ratio[0] + pca.explained_variance_ratio[1], 1.0, 1e-12);
+    EXPECT_NEAR(pca.components(0, 0), 1.0 / std::sqrt(5.0), 1e-4);
+    EXPECT_NEAR(pca.components(1, 0), 2.0 / std::sqrt(5.0), 1e-4);
+    EXPECT_NEAR(pca.total_variance, pca.variances[0] + pca.variances[1], 1e-9);
+
+    Common::DenseMatrix scores = Statistics::projectOntoComponents(pca, data.view());
+    double mean_score = 0.0;
+    for (size_t i = 0; i < 200; ++i) mean_score += scores(i, 0);
+    EXPECT_NEAR(mean_score / 200.0, 0.0, 1e-10);
+}
+
+TEST(PCATest, StationsAndFieldsWithStandardization) {
+    // Dwie stacje: temperatura i ciśnienie sterowane wspólnym sygnałem, wilgotność z brakami
+    std::vector<DataStructures::MeasurementSeries> stations(2);
+    for (size_t t = 0; t < 100; ++t) {
+        double s = std::sin(0.2 * t);
+        stations[0].emplace_back(15.0 + 5.0 * s, 60.0, 1013.0 + 0.5 * s);
+        stations[1].emplace_back(12.0 + 4.0 * s + 0.01 * std::cos(t), 70.0, 1008.0 + 0.4 * s);
+    }
+    stations[1][10].pressure_hpa = NAN;
+    std::vector<Statistics::MeasurementField> fields = {Statistics::MeasurementField::Temperature,
+                                                        Statistics::MeasurementField::Pressure};
+    Common::DenseMatrix data = Statistics::measurementMatrix(stations, fields);
+    EXPECT_EQ(data.rows(), 99u);
+    EXPECT_EQ(data.cols(), 4u);
+    EXPECT_DOUBLE_EQ(data(0, 2), 12.0 + 0.01);
+
+    Statistics::PCAOptions options;
+    options.standardize = true;
+    options.num_components = 2;
+    Statistics::PCAResult pca = Statistics::principalComponents(stations, fields, options);
+    EXPECT_EQ(pca.components.cols(), 2u);
+    EXPECT_NEAR(pca.total_variance, 4.0, 1e-10); // korelacja: suma wariancji = liczba kolumn
+    EXPECT_GT(pca.explained_variance_ratio[0], 0.999);
+    for (size_t r = 0; r < 4; ++r) EXPECT_NEAR(pca.components(r, 0), 0.5, 1e-3);
+}
+
+TEST(PCATest, LanczosPathMatchesFullDecomposition) {
+    // 240 kolumn, 3 składowe - używany jest Lanczos
+    const size_t samples = 400, cols = 240;
+    Common::DenseMatrix data(samples, cols);
+    for (size_t i = 0; i < samples; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            data(i, j) = 3.0 * std::sin(0.05 * i) * std::cos(0.01 * j) + std::sin(0.13 * i * (j % 7 + 1))
+                         + 0.1 * std::sin(1.3 * i + 0.7 * j);
+    Statistics::PCAOptions options;
+    options.num_components = 3;
+    Statistics::PCAResult top = Statistics::principalComponents(data.view(), options);
+    Statistics::PCAResult all = Statistics::principalComponents(data.view());
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_NEAR(top.variances[c], all.variances[c], 1e-8 * all.variances[0]);
+        for (size_t r = 0; r < cols; ++r) EXPECT_NEAR(top.components(r, c), all.components(r, c), 1e-6);
+    }
+}
+
+TEST(PCATest, UnconvergedLanczosFallsBackToFullDecomposition) {
+    // Skupione widmo kowariancji: bez restartów Lanczos nie osiąga tolerancji
+    const size_t samples = 300, cols = 220;
+    Common::DenseMatrix data(samples, cols);
+    for (size_t i = 0; i < samples; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            data(i, j) = std::sin(0.37 * (i + 1) * (j + 1)) + 0.01 * std::cos(1.1 * i * j);
+    Statistics::PCAOptions options;
+    options.num_components = 3;
+    options.lanczos_max_restarts = 0;
+    Statistics::PCAResult top = Statistics::principalComponents(data.view(), options);
+    Statistics::PCAResult all = Statistics::principalComponents(data.view());
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_NEAR(top.variances[c], all.variances[c], 1e-10 * all.variances[0]);
+        for (size_t r = 0; r < cols; ++r) EXPECT_NEAR(top.components(r, c), all.components(r, c), 1e-8);
+    }
+}
+
+TEST(PCATest, ThrowsOnInvalidInput) {
+    Common::DenseMatrix one_row(1, 3, 1.0);
+    EXPECT_THROW(Statistics::principalComponents(one_row.view()), std::runtime_error);
+    Common::DenseMatrix data(5, 2, 1.0);
+    Statistics::PCAOptions options;
+    options.num_components = 3;
+    EXPECT_THROW(Statistics::principalComponents(data.view(), options), std::runtime_error);
+    std::vector<DataStructures::MeasurementSeries> uneven = {DataStructures::MeasurementSeries(3),
+                                                             DataStructures::MeasurementSeries(4)};
+    EXPECT_THROW(Statistics::measurementMatrix(uneven, {Statistics::MeasurementField::Temperature}),
+                 std::runtime_error);
+}
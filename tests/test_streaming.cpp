@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "streaming.hpp"
+#include "interpolation.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeteoNumerical;
+
+TEST(SlidingWindowInterpolatorTest, LocalCubicReproducesCubicAndSlides) {
+    auto f = [](double t) { return 0.2 * t * t * t - t * t + 3.0; };
+    Interpolation::SlidingWindowInterpolator w(16);
+    for (int i = 0; i < 100; ++i) {
+        double t = 0.5 * i + 0.1 * std::sin(1.3 * i); // lekko nierówne próbkowanie
+        w.push(t, f(t));
+        if (i >= 3) {
+            double a = w.oldestTime(), b = w.newestTime();
+            for (double q = a; q <= b; q += 0.07 * (b - a)) EXPECT_NEAR(w(q), f(q), 1e-9 * (1.0 + std::abs(f(q))));
+        }
+    }
+    EXPECT_TRUE(w.full());
+    EXPECT_EQ(w.size(), 16u);
+    EXPECT_DOUBLE_EQ(w.timeAt(0), 0.5 * 84 + 0.1 * std::sin(1.3 * 84));
+    EXPECT_DOUBLE_EQ(w.valueAt(15), f(w.newestTime()));
+}
+
+TEST(SlidingWindowInterpolatorTest, WindowNewtonMatchesRebuiltInterpolant) {
+    const size_t k = 6;
+    Interpolation::SlidingWindowInterpolator w(k, Interpolation::StreamingScheme::WindowNewton);
+    for (int i = 0; i < 40; ++i) {
+        double t = 0.3 * i;
+        w.push(t, std::cos(t) + 0.01 * i);
+        Common::ValueSeries x, y;
+        for (size_t j = 0; j < w.size(); ++j) {
+            x.push_back(w.timeAt(j));
+            y.push_back(w.valueAt(j));
+        }
+        for (double q = x.front() - 0.1; q <= x.back() + 0.1; q += 0.05) {
+            EXPECT_NEAR(w(q), Interpolation::Lagrange::lagrangeInterpolate(x, y, q), 1e-10);
+        }
+    }
+}
+
+TEST(SlidingWindowInterpolatorTest, BatchMatchesScalar) {
+    Interpolation::SlidingWindowInterpolator w(50);
+    for (int i = 0; i < 120; ++i) w.push(0.1 * i, std::sin(0.1 * i));
+    Common::ValueSeries q, out(200);
+    for (int i = 0; i < 150; ++i) q.push_back(w.oldestTime() + 0.033 * i);
+    for (int i = 0; i < 50; ++i) q.push_back(w.oldestTime() + 4.9 * std::fmod(i * 0.618034, 1.0));
+    w.evaluate(q.data(), out.data(), q.size());
+    for (size_t i = 0; i < q.size(); ++i) {
+        EXPECT_DOUBLE_EQ(out[i], w(q[i]));
+        EXPECT_NEAR(out[i], std::sin(q[i]), 1e-5);
+    }
+}
+
+TEST(SlidingWindowInterpolatorTest, FewSamplesAndErrors) {
+    Interpolation::SlidingWindowInterpolator w(4);
+    EXPECT_THROW(w(0.0), std::runtime_error);
+    w.push(1.0, 2.0);
+    EXPECT_DOUBLE_EQ(w(5.0), 2.0);
+    w.push(2.0, 4.0);
+    EXPECT_NEAR(w(1.5), 3.0, 1e-15);
+    EXPECT_THROW(w.push(2.0, 1.0), std::runtime_error);
+    EXPECT_THROW(w.push(NAN, 1.0), std::runtime_error);
+    w.clear();
+    EXPECT_EQ(w.size(), 0u);
+    EXPECT_FALSE(w.contains(1.0));
+    EXPECT_THROW(Interpolation::SlidingWindowInterpolator(1), std::runtime_error);
+}